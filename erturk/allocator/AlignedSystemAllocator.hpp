@@ -2,13 +2,237 @@
 #define ERTURK_SYSTEM_ALLOC_H
 
 #include "../memory/Alignment.hpp"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <new>
 
+/*
+Aligned allocation on top of malloc/realloc/free.
+
+- Alignment <= alignof(std::max_align_t): malloc blocks are already aligned and used as is. No header, reallocate is a
+  plain realloc: the block is extended in place when possible and large (mmap'ed) blocks are moved with mremap by glibc,
+  page remapping instead of a byte copy.
+- Larger alignments: sizeof(void*) + Alignment - 1 extra bytes are allocated, the first aligned address after a pointer
+  sized header is returned, the header holds the malloc result. reallocate still goes through realloc and shifts the
+  content when the resized block has another alignment offset.
+- Large tier (opt-in, LargeTier = LargeMapping<...>): blocks of at least THRESHOLD bytes are mapped with mmap, no
+  header and no malloc bookkeeping. The start is aligned to the huge page size (2 MB at least) so the kernel can back
+  the block with huge pages:
+    PageKind::Transparent: regular pages and madvise(MADV_HUGEPAGE), transparent huge pages where the kernel has them.
+    PageKind::Huge2M/Huge1G: MAP_HUGETLB from the reserved huge page pool (vm.nr_hugepages), transparent huge pages
+                             when the pool is empty.
+  NUMA_NODE >= 0 binds the pages to that node with mbind before they are touched, best effort: the default policy stays
+  when the node cannot be bound. reallocate remaps (mremap) instead of copying where the kernel can.
+  The tier decides by size, large blocks must be released with deallocate(ptr, count).
+
+  using FeatureAllocator = AlignedSystemAllocator<float, 64, LargeMapping<size_t{64} << 20, PageKind::Huge2M, 1>>;
+*/
+
 namespace erturk::allocator
 {
 
-template <class T, const size_t Alignment = alignof(T)>
+enum class PageKind : uint8_t
+{
+    Transparent,
+    Huge2M,
+    Huge1G
+};
+
+// Blocks of at least THRESHOLD bytes are mapped directly, on PAGES and bound to NUMA_NODE (-1: no binding)
+template <size_t THRESHOLD = size_t{32} << 20, PageKind PAGES = PageKind::Transparent, int NUMA_NODE = -1>
+struct LargeMapping
+{
+    static_assert(THRESHOLD > 0, "Threshold must be greater than 0!");
+
+    static constexpr bool ENABLED_ = true;
+    static constexpr size_t THRESHOLD_ = THRESHOLD;
+    static constexpr PageKind PAGES_ = PAGES;
+    static constexpr int NUMA_NODE_ = NUMA_NODE;
+};
+
+// Every block comes from malloc
+struct NoLargeMapping
+{
+    static constexpr bool ENABLED_ = false;
+    static constexpr size_t THRESHOLD_ = static_cast<size_t>(-1);
+    static constexpr PageKind PAGES_ = PageKind::Transparent;
+    static constexpr int NUMA_NODE_ = -1;
+};
+
+namespace system_mapping
+{
+
+inline constexpr size_t PAGE_SIZE_ = 4096;
+inline constexpr size_t HUGE_PAGE_2M_ = size_t{1} << 21;
+inline constexpr size_t HUGE_PAGE_1G_ = size_t{1} << 30;
+inline constexpr int MPOL_BIND_ = 2;  // linux/mempolicy.h, libnuma is not needed for one syscall
+inline constexpr size_t MAX_NUMA_NODES_ = 1024;
+
+[[nodiscard]] constexpr size_t page_size(const PageKind kind) noexcept
+{
+    switch (kind)
+    {
+        case PageKind::Huge2M:
+            return HUGE_PAGE_2M_;
+        case PageKind::Huge1G:
+            return HUGE_PAGE_1G_;
+        default:
+            return PAGE_SIZE_;
+    }
+}
+
+// Length of the mapping of a block of bytes, the same for hugetlb and fallback mappings so munmap needs no state
+[[nodiscard]] constexpr size_t mapped_length(const size_t bytes, const PageKind kind) noexcept
+{
+    const size_t unit = page_size(kind);
+    return (bytes + unit - 1) & ~(unit - 1);
+}
+
+// Maps length bytes (a multiple of the page size) at an alignment aligned address
+[[nodiscard]] inline void* map_aligned(const size_t length, const size_t alignment) noexcept
+{
+    const size_t over_length = length + alignment - PAGE_SIZE_;
+
+    void* raw_memory = ::mmap(nullptr, over_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (raw_memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(raw_memory);
+    const uintptr_t aligned = (begin + alignment - 1) & ~(alignment - 1);
+    const size_t head = aligned - begin;
+    const size_t tail = over_length - head - length;
+
+    // trim the over-mapping, only the aligned part stays mapped
+    if (head != 0)
+    {
+        ::munmap(raw_memory, head);
+    }
+    if (tail != 0)
+    {
+        ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void bind_to_node(void* block, const size_t length, const int node) noexcept
+{
+    if (node < 0 || static_cast<size_t>(node) >= MAX_NUMA_NODES_)
+    {
+        return;
+    }
+
+    unsigned long node_mask[MAX_NUMA_NODES_ / (sizeof(unsigned long) * 8)]{};
+    node_mask[node / (sizeof(unsigned long) * 8)] = 1UL << (node % (sizeof(unsigned long) * 8));
+
+    // the kernel reads maxnode - 1 bits
+    ::syscall(SYS_mbind, block, length, MPOL_BIND_, node_mask, MAX_NUMA_NODES_ + 1, 0);
+}
+
+/**
+ *  @brief  Maps a block of mapped_length(bytes, kind) bytes aligned to alignment and to the huge page size.
+ *  @return The block or nullptr.
+ */
+[[nodiscard]] inline void* map_block(const size_t bytes, const size_t alignment, const PageKind kind,
+                                     const int node) noexcept
+{
+    const size_t length = mapped_length(bytes, kind);
+    void* block = nullptr;
+
+    // hugetlb mappings are aligned to their page size
+    if (kind != PageKind::Transparent && alignment <= page_size(kind))
+    {
+        const int page_flag = kind == PageKind::Huge2M ? (21 << MAP_HUGE_SHIFT) : (30 << MAP_HUGE_SHIFT);
+
+        block = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_flag,
+                       -1, 0);
+
+        if (block == MAP_FAILED)
+        {
+            block = nullptr;  // empty huge page pool
+        }
+    }
+
+    if (block == nullptr)
+    {
+        const size_t huge_alignment = kind == PageKind::Huge1G ? HUGE_PAGE_1G_ : HUGE_PAGE_2M_;
+
+        block = map_aligned(length, alignment > huge_alignment ? alignment : huge_alignment);
+
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        ::madvise(block, length, MADV_HUGEPAGE);
+    }
+
+    bind_to_node(block, length, node);
+
+    return block;
+}
+
+inline void unmap_block(void* block, const size_t bytes, const PageKind kind) noexcept
+{
+    ::munmap(block, mapped_length(bytes, kind));
+}
+
+/**
+ *  @brief  Resizes a block of map_block. The pages are remapped (no copy) in place, or elsewhere when the new address
+ *          keeps the alignment. Otherwise a new block is mapped and the content is copied.
+ *  @return The block or nullptr, block stays valid on failure.
+ */
+[[nodiscard]] inline void* remap_block(void* block, const size_t old_bytes, const size_t new_bytes,
+                                       const size_t alignment, const PageKind kind, const int node) noexcept
+{
+    const size_t old_length = mapped_length(old_bytes, kind);
+    const size_t new_length = mapped_length(new_bytes, kind);
+
+    if (old_length == new_length)
+    {
+        return block;
+    }
+
+    void* remapped = ::mremap(block, old_length, new_length, 0);
+
+    if (remapped != MAP_FAILED)
+    {
+        return remapped;
+    }
+
+    if (kind == PageKind::Transparent && alignment <= PAGE_SIZE_)
+    {
+        remapped = ::mremap(block, old_length, new_length, MREMAP_MAYMOVE);
+
+        if (remapped != MAP_FAILED)
+        {
+            return remapped;
+        }
+    }
+
+    void* new_block = map_block(new_bytes, alignment, kind, node);
+
+    if (new_block == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::memcpy(new_block, block, old_bytes < new_bytes ? old_bytes : new_bytes);
+    ::munmap(block, old_length);
+
+    return new_block;
+}
+
+}  // namespace system_mapping
+
+template <class T, const size_t Alignment = alignof(T), class LargeTier = NoLargeMapping>
 class AlignedSystemAllocator
 {
     static_assert((memory::alignment::isSizePowerOfTwo(Alignment)), "Alignment must be power of 2!");
@@ -37,37 +261,92 @@ public:
 
     static pointer_type allocate(const size_t count) noexcept
     {
-        if (count == 0)
+        if (count == 0 || count > MAX_COUNT_)
         {
             return nullptr;
         }
 
-        const size_t total_required_size =
-            ((count * sizeof(T)) + sizeof(void*));  // add additional space for storing un-aligned address
+        if (is_large(count))
+        {
+            return static_cast<T*>(system_mapping::map_block(count * sizeof(T), Alignment, LargeTier::PAGES_,
+                                                             LargeTier::NUMA_NODE_));
+        }
+
+        if constexpr (!OVER_ALIGNED_)
+        {
+            return static_cast<T*>(std::malloc(count * sizeof(T)));
+        }
+        else
+        {
+            void* raw_memory = std::malloc(count * sizeof(T) + HEADER_SIZE_);
+
+            if (raw_memory == nullptr)
+            {
+                return nullptr;
+            }
+            T* aligned_addr = alignAddress(raw_memory);
+            storeRawAddress(aligned_addr, raw_memory);
 
-        const size_t rounded_total_size = memory::alignment::advanceSizeByAlignment(total_required_size, Alignment);
+            return aligned_addr;
+        }
+    }
 
-        void* raw_memory = std::malloc(rounded_total_size);
+    /**
+     *  @brief  Resize memory with realloc semantics: content up to the smaller count is kept, on failure nullptr is
+     *          returned and ptr stays valid. Bytes are moved without constructors, only for trivially relocatable T.
+     *  @param  ptr  Pointer returned by allocate/reallocate or nullptr.
+     *  @param  old_count  The number of objects space was allocated for.
+     *  @param  new_count  The number of objects space is requested for.
+     */
+    static pointer_type reallocate(T* ptr, const size_t old_count, const size_t new_count) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return allocate(new_count);
+        }
 
-        if (raw_memory == nullptr)
+        if (new_count == 0 || new_count > MAX_COUNT_)
         {
             return nullptr;
         }
 
-        // check raw_memory is already aligned if we're lucky
-        if (memory::alignment::isAddressAligned(raw_memory, Alignment))
+        if (is_large(old_count) || is_large(new_count))
         {
-            return storeAndAlign(raw_memory);
+            return reallocate_large(ptr, old_count, new_count);
         }
 
-        void* advanced_addr = memory::alignment::advanceAddressByAlignment(raw_memory, Alignment);
-        if (advanced_addr == nullptr)
+        if constexpr (!OVER_ALIGNED_)
         {
-            std::free(static_cast<void*>(raw_memory));
-            return nullptr;
+            return static_cast<T*>(std::realloc(static_cast<void*>(ptr), new_count * sizeof(T)));
         }
+        else
+        {
+            void* raw_memory = loadRawAddress(ptr);
+            const size_t old_offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(raw_memory);
+
+            void* new_raw_memory = std::realloc(raw_memory, new_count * sizeof(T) + HEADER_SIZE_);
+
+            if (new_raw_memory == nullptr)
+            {
+                return nullptr;
+            }
+
+            T* aligned_addr = alignAddress(new_raw_memory);
+            const size_t new_offset =
+                reinterpret_cast<uintptr_t>(aligned_addr) - reinterpret_cast<uintptr_t>(new_raw_memory);
+
+            // realloc keeps the bytes at the old offset, the aligned address may be at another one. Shift before the
+            // header is written, the header may overlap the content at the old offset.
+            if (new_offset != old_offset)
+            {
+                const size_t kept_count = old_count < new_count ? old_count : new_count;
+                std::memmove(static_cast<void*>(aligned_addr), static_cast<unsigned char*>(new_raw_memory) + old_offset,
+                             kept_count * sizeof(T));
+            }
+            storeRawAddress(aligned_addr, new_raw_memory);
 
-        return storeAndAlign(advanced_addr);
+            return aligned_addr;
+        }
     }
 
     /**
@@ -75,42 +354,37 @@ public:
      *  @param  ptr  Pointer to the memory to deallocate.
      *  @param  n  The number of objects space was allocated for.
      */
-    static void deallocate(T* ptr, const size_t) noexcept
+    static void deallocate(T* ptr, const size_t count) noexcept
     {
-        if (ptr != nullptr)
+        if (ptr != nullptr && is_large(count))
         {
-            // retrieve un-aligned memory address just before provided aligned address
-            void* un_aligned_addr = memory::alignment::rewindAddressByAlignment(ptr, Alignment);
-            if (un_aligned_addr == nullptr)
-            {
-                // something's went wrong! (raw memory may corrupt or override!)
-                std::free(static_cast<T*>(ptr));
-                return;
-            }
-            std::free(static_cast<T*>(un_aligned_addr));
+            system_mapping::unmap_block(static_cast<void*>(ptr), count * sizeof(T), LargeTier::PAGES_);
+            return;
         }
+        deallocate(ptr);
     }
 
+    // Blocks below the large tier threshold only
     static void deallocate(T* ptr) noexcept
     {
         if (ptr != nullptr)
         {
-            // retrieve un-aligned memory address just before provided aligned address
-            void* un_aligned_addr = memory::alignment::rewindAddressByAlignment(ptr, Alignment);
-            if (un_aligned_addr == nullptr)
+            if constexpr (!OVER_ALIGNED_)
             {
-                // something's went wrong! (raw memory may corrupt or override!)
-                std::free(static_cast<T*>(ptr));
-                return;
+                std::free(static_cast<void*>(ptr));
+            }
+            else
+            {
+                // un-aligned malloc address is stored just before the aligned address
+                std::free(loadRawAddress(ptr));
             }
-            std::free(static_cast<T*>(un_aligned_addr));
         }
     }
 
     template <typename U>
     struct rebind
     {
-        using other = AlignedSystemAllocator<U>;
+        using other = AlignedSystemAllocator<U, alignof(U), LargeTier>;
     };
 
     template <typename U, typename... Args>
@@ -132,27 +406,65 @@ public:
     }
 
 private:
-    static T* storeAndAlign(void* addr)
+    // malloc result is used as is up to max_align_t, larger alignments need a header to find the malloc result
+    static constexpr bool OVER_ALIGNED_ = Alignment > alignof(std::max_align_t);
+    static constexpr size_t HEADER_SIZE_ = OVER_ALIGNED_ ? sizeof(void*) + Alignment - 1 : 0;
+    static constexpr size_t MAX_COUNT_ = (static_cast<size_t>(-1) - HEADER_SIZE_) / sizeof(T);
+
+    [[nodiscard]] static constexpr bool is_large(const size_t count) noexcept
     {
-        // store aligned memory address into aligned base address
-        *((void**)static_cast<unsigned char*>(addr)) = addr;
+        if constexpr (LargeTier::ENABLED_)
+        {
+            return count >= (LargeTier::THRESHOLD_ + sizeof(T) - 1) / sizeof(T);
+        }
+        return false;
+    }
 
-        void* advanced_addr = memory::alignment::advanceAddressByAlignment(addr, Alignment);
-        if (advanced_addr == nullptr)
+    // At least one of the counts is in the large tier
+    static pointer_type reallocate_large(T* ptr, const size_t old_count, const size_t new_count) noexcept
+    {
+        if (is_large(old_count) && is_large(new_count))
         {
-            std::free(static_cast<void*>(addr));
-            return nullptr;
+            return static_cast<T*>(system_mapping::remap_block(static_cast<void*>(ptr), old_count * sizeof(T),
+                                                               new_count * sizeof(T), Alignment, LargeTier::PAGES_,
+                                                               LargeTier::NUMA_NODE_));
         }
 
-        if (!memory::alignment::isAddressAligned(advanced_addr, Alignment))
+        // crossing the threshold, the block moves between malloc and a mapping
+        T* new_ptr = allocate(new_count);
+
+        if (new_ptr == nullptr)
         {
-            // still?!
-            std::free(static_cast<void*>(addr));
             return nullptr;
         }
 
-        // return next aligned memory address just after base address
-        return static_cast<T*>(advanced_addr);
+        const size_t kept_count = old_count < new_count ? old_count : new_count;
+        std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr), kept_count * sizeof(T));
+        deallocate(ptr, old_count);
+
+        return new_ptr;
+    }
+
+    // first aligned address leaving room for the header
+    static T* alignAddress(void* raw_memory) noexcept
+    {
+        const uintptr_t aligned_addr =
+            (reinterpret_cast<uintptr_t>(raw_memory) + sizeof(void*) + Alignment - 1) & ~(uintptr_t{Alignment} - 1);
+
+        return reinterpret_cast<T*>(aligned_addr);
+    }
+
+    // un-aligned memory address is stored just before the aligned address
+    static void storeRawAddress(T* aligned_addr, void* raw_memory) noexcept
+    {
+        std::memcpy(reinterpret_cast<unsigned char*>(aligned_addr) - sizeof(void*), &raw_memory, sizeof(void*));
+    }
+
+    static void* loadRawAddress(const T* aligned_addr) noexcept
+    {
+        void* raw_memory = nullptr;
+        std::memcpy(&raw_memory, reinterpret_cast<const unsigned char*>(aligned_addr) - sizeof(void*), sizeof(void*));
+        return raw_memory;
     }
 };
 
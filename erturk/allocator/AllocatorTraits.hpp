@@ -0,0 +1,146 @@
+#ifndef ERTURK_ALLOCATOR_TRAITS_H
+#define ERTURK_ALLOCATOR_TRAITS_H
+
+#include <type_traits>
+#include <utility>
+
+/*
+Allocator instances in containers.
+
+A container stores its allocator in an AllocatorHolder base. An empty allocator (every static allocator of erturk) is
+held as a base class, empty-base optimization keeps the container size unchanged. A stateful allocator (an arena
+pointer, a NUMA node, a quota) is held as a member.
+
+AllocatorTraits reads the optional std-style members of an allocator, missing members default like
+std::allocator_traits:
+- propagate_on_container_copy_assignment / _move_assignment / _swap : false
+- is_always_equal                                                   : allocator is an empty class
+- select_on_container_copy_construction()                           : a copy of the allocator
+Two allocators compare equal when memory of one can be freed by the other, a stateful allocator needs operator==.
+*/
+namespace erturk::allocator
+{
+
+template <class Allocator>
+struct AllocatorTraits
+{
+private:
+    static constexpr bool pocca() noexcept
+    {
+        if constexpr (requires { typename Allocator::propagate_on_container_copy_assignment; })
+        {
+            return Allocator::propagate_on_container_copy_assignment::value;
+        }
+        return false;
+    }
+
+    static constexpr bool pocma() noexcept
+    {
+        if constexpr (requires { typename Allocator::propagate_on_container_move_assignment; })
+        {
+            return Allocator::propagate_on_container_move_assignment::value;
+        }
+        return false;
+    }
+
+    static constexpr bool pocs() noexcept
+    {
+        if constexpr (requires { typename Allocator::propagate_on_container_swap; })
+        {
+            return Allocator::propagate_on_container_swap::value;
+        }
+        return false;
+    }
+
+    static constexpr bool always_equal() noexcept
+    {
+        if constexpr (requires { typename Allocator::is_always_equal; })
+        {
+            return Allocator::is_always_equal::value;
+        }
+        return std::is_empty_v<Allocator>;
+    }
+
+public:
+    static constexpr bool propagate_on_copy_assignment = pocca();
+    static constexpr bool propagate_on_move_assignment = pocma();
+    static constexpr bool propagate_on_swap = pocs();
+    static constexpr bool is_always_equal = always_equal();
+
+    [[nodiscard]] static Allocator select_on_copy_construction(const Allocator& allocator)
+    {
+        if constexpr (requires { allocator.select_on_container_copy_construction(); })
+        {
+            return allocator.select_on_container_copy_construction();
+        }
+        else
+        {
+            return allocator;
+        }
+    }
+
+    // Memory of lhs can be freed through rhs
+    [[nodiscard]] static bool equal(const Allocator& lhs, const Allocator& rhs) noexcept
+    {
+        if constexpr (is_always_equal)
+        {
+            return true;
+        }
+        else
+        {
+            return lhs == rhs;
+        }
+    }
+};
+
+// Empty allocators are a base class (no storage), others a member
+template <class Allocator, bool = std::is_empty_v<Allocator> && !std::is_final_v<Allocator>>
+class AllocatorHolder : private Allocator
+{
+public:
+    AllocatorHolder() = default;
+
+    explicit AllocatorHolder(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>)
+        : Allocator(allocator)
+    {
+    }
+
+    [[nodiscard]] Allocator& allocator_instance() noexcept
+    {
+        return *this;
+    }
+
+    [[nodiscard]] const Allocator& allocator_instance() const noexcept
+    {
+        return *this;
+    }
+};
+
+template <class Allocator>
+class AllocatorHolder<Allocator, false>
+{
+public:
+    AllocatorHolder() = default;
+
+    explicit AllocatorHolder(const Allocator& allocator) noexcept(std::is_nothrow_copy_constructible_v<Allocator>)
+        : allocator_(allocator)
+    {
+    }
+
+    [[nodiscard]] Allocator& allocator_instance() noexcept
+    {
+        return allocator_;
+    }
+
+    [[nodiscard]] const Allocator& allocator_instance() const noexcept
+    {
+        return allocator_;
+    }
+
+private:
+    Allocator allocator_{};
+};
+
+}  // namespace erturk::allocator
+
+#endif  // ERTURK_ALLOCATOR_TRAITS_H
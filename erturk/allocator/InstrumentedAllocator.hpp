@@ -0,0 +1,473 @@
+#ifndef ERTURK_INSTRUMENTED_ALLOC_H
+#define ERTURK_INSTRUMENTED_ALLOC_H
+
+#include "AlignedSystemAllocator.hpp"
+#include "AllocatorTraits.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+Allocation statistics.
+
+InstrumentedAllocator<T, Allocator, Tag> forwards to Allocator (static or stateful, kept by AllocatorHolder) and counts
+into the calling thread's counters of Tag:
+- allocations, deallocations, reallocations
+- bytes allocated / deallocated, live bytes and the thread's peak of live bytes
+- a size-class histogram, bucket b counts requests of (2^(b-1), 2^b] bytes
+
+Only the owning thread writes its counters (relaxed load + store, no locked instruction), snapshots read them from any
+thread. A thread registers its counters with the Tag registry on first use and folds them into the registry when it
+exits, memory freed on another thread than it was allocated shows as negative live bytes of that thread, the sum is
+right.
+
+  struct StringTag {};
+  using TracedString = BaseString<char, InstrumentedAllocator<char, AlignedSystemAllocator<char>, StringTag>>;
+  ...
+  const AllocationSnapshot stats = allocation_stats<StringTag>();  // every thread, exited ones included
+  stats.visit([](const char* name, const int64_t value) { ... });
+
+Defining ERTURK_DISABLE_ALLOCATION_STATS turns the wrapper into plain forwarding, snapshots are empty.
+*/
+namespace erturk::allocator
+{
+
+#if defined(ERTURK_DISABLE_ALLOCATION_STATS)
+inline constexpr bool ALLOCATION_STATS_ENABLED_ = false;
+#else
+inline constexpr bool ALLOCATION_STATS_ENABLED_ = true;
+#endif
+
+struct DefaultStatsTag
+{
+};
+
+struct AllocationSnapshot
+{
+    static constexpr size_t HISTOGRAM_BUCKETS_ = 64;
+
+    uint64_t allocations_{0};
+    uint64_t deallocations_{0};
+    uint64_t reallocations_{0};
+    uint64_t bytes_allocated_{0};
+    uint64_t bytes_deallocated_{0};
+    int64_t live_bytes_{0};
+    uint64_t peak_bytes_{0};  // largest peak of a single thread
+    uint64_t histogram_[HISTOGRAM_BUCKETS_]{};
+
+    // Largest request size of a histogram bucket
+    [[nodiscard]] static constexpr uint64_t bucket_limit(const size_t bucket) noexcept
+    {
+        return bucket >= HISTOGRAM_BUCKETS_ - 1 ? static_cast<uint64_t>(-1) : uint64_t{1} << bucket;
+    }
+
+    // Calls visitor(name, value) for every counter and non-empty histogram bucket ("le_<limit>")
+    template <class Visitor>
+    void visit(Visitor&& visitor) const
+    {
+        visitor("allocations", static_cast<int64_t>(allocations_));
+        visitor("deallocations", static_cast<int64_t>(deallocations_));
+        visitor("reallocations", static_cast<int64_t>(reallocations_));
+        visitor("bytes_allocated", static_cast<int64_t>(bytes_allocated_));
+        visitor("bytes_deallocated", static_cast<int64_t>(bytes_deallocated_));
+        visitor("live_bytes", live_bytes_);
+        visitor("peak_bytes", static_cast<int64_t>(peak_bytes_));
+
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS_; bucket++)
+        {
+            if (histogram_[bucket] != 0)
+            {
+                char name[24] = "le_";
+                write_decimal(name + 3, bucket_limit(bucket));
+                visitor(static_cast<const char*>(name), static_cast<int64_t>(histogram_[bucket]));
+            }
+        }
+    }
+
+private:
+    static void write_decimal(char* out, uint64_t value) noexcept
+    {
+        char digits[20];
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        while (count != 0)
+        {
+            *out++ = digits[--count];
+        }
+        *out = '\0';
+    }
+};
+
+namespace stats
+{
+
+[[nodiscard]] inline size_t histogram_bucket(const size_t bytes) noexcept
+{
+    return bytes <= 1 ? 0 : static_cast<size_t>(std::bit_width(bytes - 1));
+}
+
+class ThreadCounters
+{
+public:
+    void on_allocate(const size_t bytes) noexcept
+    {
+        add(allocations_, 1);
+        add(bytes_allocated_, bytes);
+        add(histogram_[histogram_bucket(bytes)], 1);
+        grow_live(static_cast<int64_t>(bytes));
+    }
+
+    void on_deallocate(const size_t bytes) noexcept
+    {
+        add(deallocations_, 1);
+        add(bytes_deallocated_, bytes);
+        live_bytes_.store(live_bytes_.load(std::memory_order_relaxed) - static_cast<int64_t>(bytes),
+                          std::memory_order_relaxed);
+    }
+
+    void on_reallocate(const size_t old_bytes, const size_t new_bytes) noexcept
+    {
+        add(reallocations_, 1);
+        add(bytes_allocated_, new_bytes);
+        add(bytes_deallocated_, old_bytes);
+        add(histogram_[histogram_bucket(new_bytes)], 1);
+        grow_live(static_cast<int64_t>(new_bytes) - static_cast<int64_t>(old_bytes));
+    }
+
+    // Adds these counters to snapshot, peaks are combined with max
+    void accumulate(AllocationSnapshot& snapshot) const noexcept
+    {
+        snapshot.allocations_ += allocations_.load(std::memory_order_relaxed);
+        snapshot.deallocations_ += deallocations_.load(std::memory_order_relaxed);
+        snapshot.reallocations_ += reallocations_.load(std::memory_order_relaxed);
+        snapshot.bytes_allocated_ += bytes_allocated_.load(std::memory_order_relaxed);
+        snapshot.bytes_deallocated_ += bytes_deallocated_.load(std::memory_order_relaxed);
+        snapshot.live_bytes_ += live_bytes_.load(std::memory_order_relaxed);
+
+        const uint64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+        if (peak > snapshot.peak_bytes_)
+        {
+            snapshot.peak_bytes_ = peak;
+        }
+
+        for (size_t bucket = 0; bucket < AllocationSnapshot::HISTOGRAM_BUCKETS_; bucket++)
+        {
+            snapshot.histogram_[bucket] += histogram_[bucket].load(std::memory_order_relaxed);
+        }
+    }
+
+public:
+    ThreadCounters* next_{nullptr};  // registry list, guarded by the registry mutex
+
+private:
+    // Single writer, a plain add is enough
+    static void add(std::atomic<uint64_t>& counter, const uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void grow_live(const int64_t delta) noexcept
+    {
+        const int64_t live = live_bytes_.load(std::memory_order_relaxed) + delta;
+        live_bytes_.store(live, std::memory_order_relaxed);
+
+        if (live > 0 && static_cast<uint64_t>(live) > peak_bytes_.load(std::memory_order_relaxed))
+        {
+            peak_bytes_.store(static_cast<uint64_t>(live), std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> deallocations_{0};
+    std::atomic<uint64_t> reallocations_{0};
+    std::atomic<uint64_t> bytes_allocated_{0};
+    std::atomic<uint64_t> bytes_deallocated_{0};
+    std::atomic<int64_t> live_bytes_{0};
+    std::atomic<uint64_t> peak_bytes_{0};
+    std::atomic<uint64_t> histogram_[AllocationSnapshot::HISTOGRAM_BUCKETS_]{};
+};
+
+// Counters of every live thread and the folded counters of exited threads, one registry per Tag
+class StatsRegistry
+{
+public:
+    void attach(ThreadCounters* counters) noexcept
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        counters->next_ = threads_;
+        threads_ = counters;
+    }
+
+    void detach(ThreadCounters* counters) noexcept
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        counters->accumulate(exited_);
+
+        ThreadCounters** link = &threads_;
+        while (*link != counters)
+        {
+            link = &(*link)->next_;
+        }
+        *link = counters->next_;
+    }
+
+    // Records of a thread whose counters are gone (thread_local destructors running after them)
+    template <class Record>
+    void record_exited(Record&& record) noexcept
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        record(late_);
+    }
+
+    [[nodiscard]] AllocationSnapshot snapshot() noexcept
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        AllocationSnapshot snapshot = exited_;
+        late_.accumulate(snapshot);
+        for (ThreadCounters* counters = threads_; counters != nullptr; counters = counters->next_)
+        {
+            counters->accumulate(snapshot);
+        }
+        return snapshot;
+    }
+
+private:
+    std::mutex mutex_{};
+    ThreadCounters* threads_{nullptr};
+    AllocationSnapshot exited_{};
+    ThreadCounters late_{};
+};
+
+// Never destroyed, threads may exit after static destruction started
+template <class Tag>
+[[nodiscard]] inline StatsRegistry& stats_registry() noexcept
+{
+    static StatsRegistry* registry = new StatsRegistry{};
+    return *registry;
+}
+
+template <class Tag>
+inline thread_local bool thread_counters_released_ = false;
+
+template <class Tag>
+struct ThreadCountersGuard
+{
+    ThreadCountersGuard() noexcept
+    {
+        stats_registry<Tag>().attach(&counters_);
+    }
+
+    ~ThreadCountersGuard()
+    {
+        stats_registry<Tag>().detach(&counters_);
+        thread_counters_released_<Tag> = true;
+    }
+
+    ThreadCounters counters_{};
+};
+
+template <class Tag>
+[[nodiscard]] inline ThreadCounters& thread_counters() noexcept
+{
+    thread_local ThreadCountersGuard<Tag> guard{};
+    return guard.counters_;
+}
+
+// Applies record to the calling thread's counters of Tag
+template <class Tag, class Record>
+inline void record(Record&& record) noexcept
+{
+    if (!thread_counters_released_<Tag>)
+    {
+        record(thread_counters<Tag>());
+    }
+    else
+    {
+        stats_registry<Tag>().record_exited(record);
+    }
+}
+
+}  // namespace stats
+
+// Every thread of Tag, exited threads included
+template <class Tag = DefaultStatsTag>
+[[nodiscard]] inline AllocationSnapshot allocation_stats() noexcept
+{
+    if constexpr (ALLOCATION_STATS_ENABLED_)
+    {
+        return stats::stats_registry<Tag>().snapshot();
+    }
+    return AllocationSnapshot{};
+}
+
+// The calling thread of Tag only
+template <class Tag = DefaultStatsTag>
+[[nodiscard]] inline AllocationSnapshot thread_allocation_stats() noexcept
+{
+    AllocationSnapshot snapshot{};
+    if constexpr (ALLOCATION_STATS_ENABLED_)
+    {
+        stats::record<Tag>([&snapshot](const stats::ThreadCounters& counters) { counters.accumulate(snapshot); });
+    }
+    return snapshot;
+}
+
+template <class T, class Allocator = AlignedSystemAllocator<T, alignof(T)>, class Tag = DefaultStatsTag>
+class InstrumentedAllocator : private AllocatorHolder<Allocator>
+{
+    using Holder = AllocatorHolder<Allocator>;
+    using Traits = AllocatorTraits<Allocator>;
+
+public:
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer_type;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T value_type;
+
+    // Containers see the propagation of the wrapped allocator
+    using propagate_on_container_copy_assignment = std::bool_constant<Traits::propagate_on_copy_assignment>;
+    using propagate_on_container_move_assignment = std::bool_constant<Traits::propagate_on_move_assignment>;
+    using propagate_on_container_swap = std::bool_constant<Traits::propagate_on_swap>;
+    using is_always_equal = std::bool_constant<Traits::is_always_equal>;
+
+public:
+    InstrumentedAllocator() = default;
+
+    explicit InstrumentedAllocator(const Allocator& allocator) noexcept : Holder{allocator} {}
+
+    template <class U, class OtherAllocator>
+    InstrumentedAllocator(const InstrumentedAllocator<U, OtherAllocator, Tag>& other) noexcept
+        : Holder{Allocator(other.inner())}
+    {
+    }
+
+    [[nodiscard]] pointer_type allocate(const size_t count) noexcept
+    {
+        T* ptr = this->allocator_instance().allocate(count);
+
+        if constexpr (ALLOCATION_STATS_ENABLED_)
+        {
+            if (ptr != nullptr)
+            {
+                stats::record<Tag>([count](stats::ThreadCounters& counters) {
+                    counters.on_allocate(count * sizeof(T));
+                });
+            }
+        }
+        return ptr;
+    }
+
+    // Only where the wrapped allocator has it, containers detect reallocate
+    [[nodiscard]] pointer_type reallocate(T* ptr, const size_t old_count, const size_t new_count) noexcept
+        requires requires(Allocator& allocator) { allocator.reallocate(ptr, old_count, new_count); }
+    {
+        T* new_ptr = this->allocator_instance().reallocate(ptr, old_count, new_count);
+
+        if constexpr (ALLOCATION_STATS_ENABLED_)
+        {
+            if (new_ptr != nullptr)
+            {
+                stats::record<Tag>([ptr, old_count, new_count](stats::ThreadCounters& counters) {
+                    if (ptr == nullptr)
+                    {
+                        counters.on_allocate(new_count * sizeof(T));
+                    }
+                    else
+                    {
+                        counters.on_reallocate(old_count * sizeof(T), new_count * sizeof(T));
+                    }
+                });
+            }
+        }
+        return new_ptr;
+    }
+
+    void deallocate(T* ptr, const size_t count) noexcept
+    {
+        if constexpr (ALLOCATION_STATS_ENABLED_)
+        {
+            if (ptr != nullptr)
+            {
+                stats::record<Tag>([count](stats::ThreadCounters& counters) {
+                    counters.on_deallocate(count * sizeof(T));
+                });
+            }
+        }
+        this->allocator_instance().deallocate(ptr, count);
+    }
+
+    // The size is unknown, counted as a deallocation of 0 bytes
+    void deallocate(T* ptr) noexcept
+    {
+        if constexpr (ALLOCATION_STATS_ENABLED_)
+        {
+            if (ptr != nullptr)
+            {
+                stats::record<Tag>([](stats::ThreadCounters& counters) { counters.on_deallocate(0); });
+            }
+        }
+        this->allocator_instance().deallocate(ptr);
+    }
+
+    [[nodiscard]] const Allocator& inner() const noexcept
+    {
+        return this->allocator_instance();
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = InstrumentedAllocator<U, typename Allocator::template rebind<U>::other, Tag>;
+    };
+
+    template <typename U, typename... Args>
+    static void construct(U* addr, Args&&... args)
+    {
+        if (addr != nullptr)
+        {
+            new (addr) U{std::forward<Args>(args)...};  // construct at
+        }
+    }
+
+    template <typename U>
+    static void destroy(U* addr)
+    {
+        if (addr != nullptr)
+        {
+            addr->~U();
+        }
+    }
+
+    template <class U, class OtherAllocator>
+    [[nodiscard]] bool operator==(const InstrumentedAllocator<U, OtherAllocator, Tag>& other) const noexcept
+    {
+        if constexpr (Traits::is_always_equal)
+        {
+            return true;
+        }
+        else
+        {
+            return inner() == other.inner();
+        }
+    }
+};
+
+}  // namespace erturk::allocator
+
+#endif  // ERTURK_INSTRUMENTED_ALLOC_H
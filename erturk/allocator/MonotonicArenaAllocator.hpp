@@ -0,0 +1,451 @@
+#ifndef ERTURK_MONOTONIC_ARENA_ALLOC_H
+#define ERTURK_MONOTONIC_ARENA_ALLOC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+/*
+Bump-pointer allocation from a chain of blocks.
+
+- allocate  : aligns the cursor and bumps it, a new block is chained when the current one is full. Blocks grow
+              geometrically, a request larger than the next block gets a block of its own.
+- deallocate: no-op, except that the most recent allocation is rolled back when its size is known.
+- reset     : O(1), the cursor goes back to the first block. Every block is kept and refilled in chain order, a
+              request-scoped workload stops paying for malloc/free after its first request.
+- release   : gives every block back to the system.
+
+MonotonicArenaAllocator<T, Tag> is the static allocator interface over a per-thread arena of Tag (shared by every T):
+  struct RequestTag {};
+  using Strings = DynamicTypeBufferArray<String, MonotonicArenaAllocator<String, RequestTag>>;
+  ... handle the request ...
+  MonotonicArenaAllocator<String, RequestTag>::reset();  // everything of the request is gone at once
+Objects must be destroyed (or be trivially destructible) before reset, and must not outlive the allocating thread.
+
+ArenaAllocator<T> is the stateful interface over a caller-owned arena, the container stores the arena pointer:
+  MonotonicArena parse_arena{}, render_arena{};
+  DynamicTypeBufferArray<int, ArenaAllocator<int>> tokens{ArenaAllocator<int>{parse_arena}};
+Two pipelines on the same thread keep their memory apart. The allocator does not propagate on copy/move assignment
+or swap, a container moved into one on another arena copies its elements.
+*/
+namespace erturk::allocator
+{
+
+class MonotonicArena final
+{
+    static constexpr size_t DEFAULT_BLOCK_SIZE_ = 4096;
+    static constexpr size_t MAX_BLOCK_SIZE_ = size_t{1} << 20;
+
+    struct Block
+    {
+        Block* next_;
+        size_t capacity_;  // usable bytes after the header
+    };
+
+    static constexpr size_t HEADER_SIZE_ = (sizeof(Block) + alignof(std::max_align_t) - 1) &
+                                           ~(alignof(std::max_align_t) - 1);
+
+public:
+    explicit MonotonicArena(const size_t initial_block_size = DEFAULT_BLOCK_SIZE_) noexcept
+        : next_block_size_{initial_block_size}
+    {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena()
+    {
+        release();
+    }
+
+    [[nodiscard]] void* allocate(const size_t bytes, const size_t alignment) noexcept
+    {
+        void* ptr = bump(bytes, alignment);
+        if (ptr != nullptr)
+        {
+            return ptr;
+        }
+
+        // Retained blocks after the current one (after a reset) are refilled first
+        while (current_ != nullptr && current_->next_ != nullptr)
+        {
+            enter(current_->next_);
+
+            ptr = bump(bytes, alignment);
+            if (ptr != nullptr)
+            {
+                return ptr;
+            }
+        }
+
+        if (!chain_block(bytes + alignment))
+        {
+            return nullptr;
+        }
+        return bump(bytes, alignment);
+    }
+
+    // Extends the most recent allocation in place
+    [[nodiscard]] bool try_extend(void* ptr, const size_t old_bytes, const size_t new_bytes) noexcept
+    {
+        unsigned char* begin = static_cast<unsigned char*>(ptr);
+
+        if (begin + old_bytes != cursor_ || begin + new_bytes > end_)
+        {
+            return false;
+        }
+
+        cursor_ = begin + new_bytes;
+        return true;
+    }
+
+    // Gives the most recent allocation back, any other allocation waits for reset
+    void rollback(void* ptr, const size_t bytes) noexcept
+    {
+        unsigned char* begin = static_cast<unsigned char*>(ptr);
+
+        if (begin + bytes == cursor_)
+        {
+            cursor_ = begin;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (head_ != nullptr)
+        {
+            enter(head_);
+        }
+    }
+
+    void release() noexcept
+    {
+        Block* block = head_;
+        while (block != nullptr)
+        {
+            Block* next = block->next_;
+            std::free(block);
+            block = next;
+        }
+
+        head_ = nullptr;
+        current_ = nullptr;
+        cursor_ = nullptr;
+        end_ = nullptr;
+    }
+
+private:
+    [[nodiscard]] void* bump(const size_t bytes, const size_t alignment) noexcept
+    {
+        if (cursor_ == nullptr)
+        {
+            return nullptr;
+        }
+
+        const uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+
+        if (aligned > reinterpret_cast<uintptr_t>(end_) || bytes > reinterpret_cast<uintptr_t>(end_) - aligned)
+        {
+            return nullptr;
+        }
+
+        cursor_ = reinterpret_cast<unsigned char*>(aligned + bytes);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void enter(Block* block) noexcept
+    {
+        current_ = block;
+        cursor_ = reinterpret_cast<unsigned char*>(block) + HEADER_SIZE_;
+        end_ = cursor_ + block->capacity_;
+    }
+
+    // Appends a block of at least required bytes after the last block
+    [[nodiscard]] bool chain_block(const size_t required) noexcept
+    {
+        const size_t capacity = required > next_block_size_ ? required : next_block_size_;
+
+        if (capacity > static_cast<size_t>(-1) - HEADER_SIZE_)
+        {
+            return false;
+        }
+
+        Block* block = static_cast<Block*>(std::malloc(HEADER_SIZE_ + capacity));
+
+        if (block == nullptr)
+        {
+            return false;
+        }
+
+        block->next_ = nullptr;
+        block->capacity_ = capacity;
+
+        if (current_ == nullptr)
+        {
+            head_ = block;
+        }
+        else
+        {
+            current_->next_ = block;
+        }
+
+        if (next_block_size_ < MAX_BLOCK_SIZE_)
+        {
+            next_block_size_ *= 2;
+        }
+
+        enter(block);
+        return true;
+    }
+
+private:
+    Block* head_{nullptr};
+    Block* current_{nullptr};
+    unsigned char* cursor_{nullptr};
+    unsigned char* end_{nullptr};
+    size_t next_block_size_;
+};
+
+struct DefaultArenaTag
+{
+};
+
+// One arena per thread and Tag
+template <class Tag>
+[[nodiscard]] inline MonotonicArena& monotonic_arena() noexcept
+{
+    thread_local MonotonicArena arena{};
+    return arena;
+}
+
+template <class T, class Tag = DefaultArenaTag>
+class MonotonicArenaAllocator
+{
+public:
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer_type;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T value_type;
+
+public:
+    constexpr MonotonicArenaAllocator() noexcept = default;
+
+    template <class U>
+    constexpr MonotonicArenaAllocator(const MonotonicArenaAllocator<U, Tag>&) noexcept
+    {
+    }
+
+    static pointer_type allocate(const size_t count) noexcept
+    {
+        if (count == 0 || count > MAX_COUNT_)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(monotonic_arena<Tag>().allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     *  @brief  Resize memory with realloc semantics, the most recent allocation grows in place. Otherwise a new
+     *          range is bumped and the old one is left to reset. Only for trivially relocatable T.
+     */
+    static pointer_type reallocate(T* ptr, const size_t old_count, const size_t new_count) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return allocate(new_count);
+        }
+
+        if (new_count == 0 || new_count > MAX_COUNT_)
+        {
+            return nullptr;
+        }
+
+        if (new_count <= old_count || monotonic_arena<Tag>().try_extend(ptr, old_count * sizeof(T),
+                                                                         new_count * sizeof(T)))
+        {
+            return ptr;
+        }
+
+        T* new_ptr = allocate(new_count);
+        if (new_ptr != nullptr)
+        {
+            std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr), old_count * sizeof(T));
+        }
+        return new_ptr;
+    }
+
+    static void deallocate(T* ptr, const size_t count) noexcept
+    {
+        if (ptr != nullptr)
+        {
+            monotonic_arena<Tag>().rollback(ptr, count * sizeof(T));
+        }
+    }
+
+    // Memory comes back with reset
+    static void deallocate(T*) noexcept {}
+
+    // O(1), every allocation of this thread's Tag arena is gone
+    static void reset() noexcept
+    {
+        monotonic_arena<Tag>().reset();
+    }
+
+    static void release() noexcept
+    {
+        monotonic_arena<Tag>().release();
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = MonotonicArenaAllocator<U, Tag>;
+    };
+
+    template <typename U, typename... Args>
+    static void construct(U* addr, Args&&... args)
+    {
+        if (addr != nullptr)
+        {
+            new (addr) U{std::forward<Args>(args)...};  // construct at
+        }
+    }
+
+    template <typename U>
+    static void destroy(U* addr)
+    {
+        if (addr != nullptr)
+        {
+            addr->~U();
+        }
+    }
+
+    template <class U>
+    [[nodiscard]] constexpr bool operator==(const MonotonicArenaAllocator<U, Tag>&) const noexcept
+    {
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_COUNT_ = (static_cast<size_t>(-1) / 2) / sizeof(T);
+};
+
+template <class T>
+class ArenaAllocator
+{
+public:
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer_type;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T value_type;
+
+public:
+    explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_{&arena} {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_{other.arena()}
+    {
+    }
+
+    [[nodiscard]] pointer_type allocate(const size_t count) noexcept
+    {
+        if (count == 0 || count > MAX_COUNT_)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // See MonotonicArenaAllocator::reallocate
+    [[nodiscard]] pointer_type reallocate(T* ptr, const size_t old_count, const size_t new_count) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return allocate(new_count);
+        }
+
+        if (new_count == 0 || new_count > MAX_COUNT_)
+        {
+            return nullptr;
+        }
+
+        if (new_count <= old_count || arena_->try_extend(ptr, old_count * sizeof(T), new_count * sizeof(T)))
+        {
+            return ptr;
+        }
+
+        T* new_ptr = allocate(new_count);
+        if (new_ptr != nullptr)
+        {
+            std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr), old_count * sizeof(T));
+        }
+        return new_ptr;
+    }
+
+    void deallocate(T* ptr, const size_t count) noexcept
+    {
+        if (ptr != nullptr)
+        {
+            arena_->rollback(ptr, count * sizeof(T));
+        }
+    }
+
+    // Memory comes back with reset of the arena
+    void deallocate(T*) noexcept {}
+
+    [[nodiscard]] MonotonicArena* arena() const noexcept
+    {
+        return arena_;
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = ArenaAllocator<U>;
+    };
+
+    template <typename U, typename... Args>
+    static void construct(U* addr, Args&&... args)
+    {
+        if (addr != nullptr)
+        {
+            new (addr) U{std::forward<Args>(args)...};  // construct at
+        }
+    }
+
+    template <typename U>
+    static void destroy(U* addr)
+    {
+        if (addr != nullptr)
+        {
+            addr->~U();
+        }
+    }
+
+    // Same arena, memory of one can be given back through the other
+    template <class U>
+    [[nodiscard]] bool operator==(const ArenaAllocator<U>& other) const noexcept
+    {
+        return arena_ == other.arena();
+    }
+
+private:
+    static constexpr size_t MAX_COUNT_ = (static_cast<size_t>(-1) / 2) / sizeof(T);
+
+    MonotonicArena* arena_;
+};
+
+}  // namespace erturk::allocator
+
+#endif  // ERTURK_MONOTONIC_ARENA_ALLOC_H
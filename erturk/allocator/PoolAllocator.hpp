@@ -0,0 +1,234 @@
+#ifndef ERTURK_POOL_ALLOC_H
+#define ERTURK_POOL_ALLOC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+/*
+Fixed-size block pool with an intrusive free list.
+
+A free block stores the next free block in its own first bytes, there is no per-block header. Blocks are carved
+lazily from chunks of CHUNK_BLOCKS_ blocks, allocate pops the free list (or bumps the current chunk), deallocate
+pushes onto it: both O(1), no search and no size lookup. Chunks are given back to the system by release or with the
+pool.
+
+PoolAllocator<T, Tag> is the static allocator interface over a per-thread pool of Tag for blocks of sizeof(T), it
+serves single objects (count == 1, e.g. list/tree nodes), larger requests return nullptr. Rebinding to another type
+switches to the pool of that block size. Blocks must not outlive the allocating thread.
+*/
+namespace erturk::allocator
+{
+
+template <size_t BLOCK_SIZE, size_t ALIGNMENT>
+class FixedBlockPool final
+{
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "Alignment must be power of 2!");
+
+    struct FreeNode
+    {
+        FreeNode* next_;
+    };
+
+    struct Chunk
+    {
+        Chunk* next_;
+    };
+
+public:
+    static constexpr size_t CHUNK_BLOCKS_ = 256;
+
+    // Blocks hold the free list link, so they are at least as large and aligned as a pointer
+    static constexpr size_t BLOCK_ALIGNMENT_ = ALIGNMENT > alignof(FreeNode) ? ALIGNMENT : alignof(FreeNode);
+    static constexpr size_t STRIDE_ =
+        ((BLOCK_SIZE > sizeof(FreeNode) ? BLOCK_SIZE : sizeof(FreeNode)) + BLOCK_ALIGNMENT_ - 1) &
+        ~(BLOCK_ALIGNMENT_ - 1);
+
+public:
+    FixedBlockPool() noexcept = default;
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    ~FixedBlockPool()
+    {
+        release();
+    }
+
+    [[nodiscard]] void* allocate() noexcept
+    {
+        if (free_list_ != nullptr)
+        {
+            FreeNode* node = free_list_;
+            free_list_ = node->next_;
+            return node;
+        }
+
+        if (cursor_ == end_ && !chain_chunk())
+        {
+            return nullptr;
+        }
+
+        void* block = cursor_;
+        cursor_ += STRIDE_;
+        return block;
+    }
+
+    void deallocate(void* block) noexcept
+    {
+        FreeNode* node = static_cast<FreeNode*>(block);
+        node->next_ = free_list_;
+        free_list_ = node;
+    }
+
+    // Every block is gone, live objects must be destroyed first
+    void release() noexcept
+    {
+        Chunk* chunk = chunks_;
+        while (chunk != nullptr)
+        {
+            Chunk* next = chunk->next_;
+            std::free(chunk);
+            chunk = next;
+        }
+
+        chunks_ = nullptr;
+        free_list_ = nullptr;
+        cursor_ = nullptr;
+        end_ = nullptr;
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE_ = (sizeof(Chunk) + BLOCK_ALIGNMENT_ - 1) & ~(BLOCK_ALIGNMENT_ - 1);
+
+    [[nodiscard]] bool chain_chunk() noexcept
+    {
+        // over-allocate by the alignment, malloc only guarantees max_align_t
+        Chunk* chunk = static_cast<Chunk*>(std::malloc(HEADER_SIZE_ + STRIDE_ * CHUNK_BLOCKS_ + BLOCK_ALIGNMENT_));
+
+        if (chunk == nullptr)
+        {
+            return false;
+        }
+
+        chunk->next_ = chunks_;
+        chunks_ = chunk;
+
+        const uintptr_t first =
+            (reinterpret_cast<uintptr_t>(chunk) + HEADER_SIZE_ + BLOCK_ALIGNMENT_ - 1) & ~(BLOCK_ALIGNMENT_ - 1);
+
+        cursor_ = reinterpret_cast<unsigned char*>(first);
+        end_ = cursor_ + STRIDE_ * CHUNK_BLOCKS_;
+        return true;
+    }
+
+private:
+    FreeNode* free_list_{nullptr};
+    Chunk* chunks_{nullptr};
+    unsigned char* cursor_{nullptr};  // next never used block of the newest chunk
+    unsigned char* end_{nullptr};
+};
+
+struct DefaultPoolTag
+{
+};
+
+// One pool per thread, block size/alignment and Tag
+template <size_t BLOCK_SIZE, size_t ALIGNMENT, class Tag>
+[[nodiscard]] inline FixedBlockPool<BLOCK_SIZE, ALIGNMENT>& fixed_block_pool() noexcept
+{
+    thread_local FixedBlockPool<BLOCK_SIZE, ALIGNMENT> pool{};
+    return pool;
+}
+
+template <class T, class Tag = DefaultPoolTag>
+class PoolAllocator
+{
+public:
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer_type;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T value_type;
+
+public:
+    constexpr PoolAllocator() noexcept = default;
+
+    template <class U>
+    constexpr PoolAllocator(const PoolAllocator<U, Tag>&) noexcept
+    {
+    }
+
+    // Single objects only, count != 1 returns nullptr
+    static pointer_type allocate(const size_t count) noexcept
+    {
+        if (count != 1)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(pool().allocate());
+    }
+
+    static void deallocate(T* ptr, const size_t) noexcept
+    {
+        deallocate(ptr);
+    }
+
+    static void deallocate(T* ptr) noexcept
+    {
+        if (ptr != nullptr)
+        {
+            pool().deallocate(static_cast<void*>(ptr));
+        }
+    }
+
+    static void release() noexcept
+    {
+        pool().release();
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = PoolAllocator<U, Tag>;
+    };
+
+    template <typename U, typename... Args>
+    static void construct(U* addr, Args&&... args)
+    {
+        if (addr != nullptr)
+        {
+            new (addr) U{std::forward<Args>(args)...};  // construct at
+        }
+    }
+
+    template <typename U>
+    static void destroy(U* addr)
+    {
+        if (addr != nullptr)
+        {
+            addr->~U();
+        }
+    }
+
+    template <class U>
+    [[nodiscard]] constexpr bool operator==(const PoolAllocator<U, Tag>&) const noexcept
+    {
+        return sizeof(U) == sizeof(T) && alignof(U) == alignof(T);  // same pool
+    }
+
+private:
+    [[nodiscard]] static FixedBlockPool<sizeof(T), alignof(T)>& pool() noexcept
+    {
+        return fixed_block_pool<sizeof(T), alignof(T), Tag>();
+    }
+};
+
+}  // namespace erturk::allocator
+
+#endif  // ERTURK_POOL_ALLOC_H
@@ -0,0 +1,909 @@
+#ifndef ERTURK_CHANNEL_H
+#define ERTURK_CHANNEL_H
+
+#include "../../concurrency/coordination/Futex.hpp"
+#include "../../concurrency/lock_free/Backoff.hpp"
+#include "../../concurrency/lock_free/BoundedMpmcQueue.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+Go style typed channels.
+
+  Channel<T> channel{64};  // buffered, capacity rounded up to a power of two
+  Channel<T> handoff{};    // unbuffered, send returns once a receiver took the value
+
+Values travel through a lock-free BoundedMpmcQueue, a send or receive that finds room / a value never takes a lock.
+Only a thread that has to block touches the slow path: it spins for a while (Backoff), then links a node into the
+channel's wait list (mutex guarded, one list for receivers, one for senders) and sleeps on its own futex word.
+Wakers check the list's waiter count after a seq_cst fence, a send with nobody parked costs no syscall, and a send
+wakes exactly one receiver instead of every waiter.
+
+- send / receive       : blocking. send throws on a closed channel, receive returns false once the channel is closed
+                         and drained.
+- try_send/try_receive : never block. An unbuffered try_send claims one parked receiver and hands it the value
+                         directly, false when none can be claimed.
+- close                : no more sends, values already sent stay receivable, every parked thread is woken.
+- select(on_receive(channel, handler)...) : waits on several channels, runs the handler of the one that delivered.
+                         Cases are tried from a rotating start so a busy channel does not starve the others.
+                         Closed and drained channels are skipped, SELECT_CLOSED_ when every channel is.
+
+A parked select links one node per channel, all pointing to one futex word. The first channel that wakes it stores
+its case index there, the other channels skip it. If the select then completes through another case it passes the
+wakeup on, the value of the waking channel does not sit behind sleeping receivers.
+
+An unbuffered try_send does not go through the ring, a value it left there could wait for a receiver forever. It
+claims a parked receiver's node with the same CAS a wakeup uses and hands the value over with it, the claimed receiver
+takes it unless it completed in the meantime (a select through another case), then it declines and try_send returns
+false. Either way the answer comes from a receiver that is already running.
+
+If moving a value out to the receiver (or a select handler) throws, that value is dropped, its sender is still
+released and the exception propagates to the receiver.
+
+Senders of an unbuffered channel wait for their value to be taken even after close, a channel must not be
+destroyed while a thread still uses it.
+*/
+namespace erturk::communication
+{
+
+inline constexpr size_t SELECT_CLOSED_ = SIZE_MAX;     // every channel is closed and drained
+inline constexpr size_t SELECT_NONE_ = SIZE_MAX - 1;   // try_select: no channel is ready
+
+enum class ReceiveStatus
+{
+    Received,
+    Empty,
+    Closed
+};
+
+namespace channel
+{
+
+inline constexpr uint32_t WAITING_ = 0;  // else 1 + case index of the channel that woke the waiter
+
+inline constexpr uint32_t HANDOFF_PENDING_ = 0;
+inline constexpr uint32_t HANDOFF_TAKEN_ = 1;
+inline constexpr uint32_t HANDOFF_DECLINED_ = 2;
+
+// One parked thread, the futex word lives on its stack
+struct Waiter
+{
+    std::atomic<uint32_t> state_{WAITING_};
+};
+
+// The value of an unbuffered try_send, the sender waits on state_ until the claimed receiver answers
+struct Handoff
+{
+    std::atomic<uint32_t> state_{HANDOFF_PENDING_};
+    std::exception_ptr error_{};  // making the receiver's copy threw, try_send rethrows it
+};
+
+template <typename T>
+struct TypedHandoff final : Handoff
+{
+    TypedHandoff(const void* source, void (*make)(const void*, std::optional<T>&)) noexcept
+        : source_{source}, make_{make}
+    {
+    }
+
+    const void* source_;
+    void (*make_)(const void* source, std::optional<T>& out);  // copies or moves the sender's value as it was passed
+};
+
+struct WaitNode
+{
+    Waiter* waiter_;
+    uint32_t case_index_;
+    WaitNode* prev_{nullptr};
+    WaitNode* next_{nullptr};
+    bool linked_{false};
+    Handoff* handoff_{nullptr};  // set with the wakeup by a claim, read after remove
+};
+
+class WaitList final
+{
+public:
+    void enqueue(WaitNode* node) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+
+            node->prev_ = last_;
+            node->next_ = nullptr;
+            (last_ != nullptr ? last_->next_ : first_) = node;
+            last_ = node;
+            node->linked_ = true;
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // pairs with the fence in has_waiters: the caller's re-check sees the value or the waker sees the node
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // No-op when a waker already took the node
+    void remove(WaitNode* node) noexcept
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        if (node->linked_)
+        {
+            unlink(node);
+        }
+    }
+
+    [[nodiscard]] bool has_waiters() const noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return count_.load(std::memory_order_relaxed) != 0;
+    }
+
+    // Wakes the first waiter not woken by another channel yet
+    void notify_one() noexcept
+    {
+        if (!has_waiters())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        while (first_ != nullptr)
+        {
+            WaitNode* node = first_;
+            unlink(node);
+
+            if (wake(node))
+            {
+                return;
+            }
+        }
+    }
+
+    // Wakes the first waiter not woken by another channel yet and gives it handoff, false when there is none
+    [[nodiscard]] bool claim(Handoff* handoff) noexcept
+    {
+        if (!has_waiters())
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        while (first_ != nullptr)
+        {
+            WaitNode* node = first_;
+            unlink(node);
+
+            node->handoff_ = handoff;  // the waiter reads it after taking the mutex in remove
+            if (wake(node))
+            {
+                return true;
+            }
+            node->handoff_ = nullptr;
+        }
+        return false;
+    }
+
+    void notify_all() noexcept
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        while (first_ != nullptr)
+        {
+            WaitNode* node = first_;
+            unlink(node);
+            (void)wake(node);
+        }
+    }
+
+private:
+    void unlink(WaitNode* node) noexcept
+    {
+        (node->prev_ != nullptr ? node->prev_->next_ : first_) = node->next_;
+        (node->next_ != nullptr ? node->next_->prev_ : last_) = node->prev_;
+        node->linked_ = false;
+        count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static bool wake(WaitNode* node) noexcept
+    {
+        Waiter* waiter = node->waiter_;
+        uint32_t expected = WAITING_;
+
+        if (!waiter->state_.compare_exchange_strong(expected, node->case_index_ + 1, std::memory_order_release,
+                                                    std::memory_order_relaxed))
+        {
+            return false;
+        }
+        erturk::concurrency::coordination::futex_wake(waiter->state_, 1);
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    WaitNode* first_{nullptr};
+    WaitNode* last_{nullptr};
+    std::atomic<size_t> count_{0};
+};
+
+// Spins a while, then sleeps until a channel changes the waiter's state
+inline void park(Waiter& waiter) noexcept
+{
+    erturk::concurrency::lock_free::Backoff backoff{};
+
+    while (waiter.state_.load(std::memory_order_acquire) == WAITING_)
+    {
+        if (backoff.is_spinning())
+        {
+            backoff.pause();
+        }
+        else
+        {
+            erturk::concurrency::coordination::futex_wait(waiter.state_, WAITING_);
+        }
+    }
+}
+
+inline void settle(Handoff& handoff, const uint32_t state) noexcept
+{
+    handoff.state_.store(state, std::memory_order_release);
+    erturk::concurrency::coordination::futex_wake(handoff.state_, 1);
+}
+
+// Makes the handed value and passes it to consume (T&&), false when making it threw (the sender gets the exception)
+template <typename T, typename Consume>
+[[nodiscard]] bool take_handoff(Handoff& handoff, Consume& consume)
+{
+    auto& typed = static_cast<TypedHandoff<T>&>(handoff);
+    std::optional<T> value{};
+
+    try
+    {
+        typed.make_(typed.source_, value);
+    }
+    catch (...)
+    {
+        handoff.error_ = std::current_exception();
+        settle(handoff, HANDOFF_DECLINED_);
+        return false;
+    }
+
+    settle(handoff, HANDOFF_TAKEN_);  // the sender's value is not touched after this
+    consume(std::move(*value));
+    return true;
+}
+
+// The re-check after enqueue threw: unlinks the node, a wakeup it already took is passed on (a handoff declined)
+inline void abandon(WaitList& waiters, WaitNode& node) noexcept
+{
+    waiters.remove(&node);
+
+    if (node.handoff_ != nullptr)
+    {
+        settle(*node.handoff_, HANDOFF_DECLINED_);
+    }
+    else if (node.waiter_->state_.load(std::memory_order_acquire) != WAITING_)
+    {
+        waiters.notify_one();
+    }
+}
+
+struct SelectAccess;
+
+}  // namespace channel
+
+template <typename T>
+class Channel final
+{
+    friend struct channel::SelectAccess;
+
+    struct Envelope
+    {
+        T value_;
+        std::atomic<uint32_t>* delivered_;  // unbuffered only, the sender waits on it
+    };
+
+    enum class SendStatus
+    {
+        Sent,
+        Full,
+        Closed
+    };
+
+    static constexpr uint64_t CLOSED_ = 1;
+    static constexpr uint64_t SENDER_ = 2;  // senders inside a ring push, counted above the closed bit
+
+public:
+    // capacity 0 makes an unbuffered channel
+    explicit Channel(const size_t capacity = 0) noexcept(false)
+        : unbuffered_{capacity == 0}, ring_{capacity == 0 ? 1 : capacity}
+    {
+    }
+
+    Channel(const Channel&) = delete;
+
+    Channel& operator=(const Channel&) = delete;
+
+    template <typename U = T>
+    void send(U&& value) noexcept(false)
+    {
+        std::atomic<uint32_t> delivered{0};
+        std::atomic<uint32_t>* ack = unbuffered_ ? &delivered : nullptr;
+        erturk::concurrency::lock_free::Backoff backoff{};
+
+        while (true)
+        {
+            SendStatus status = try_send_envelope<U>(value, ack);
+
+            if (status == SendStatus::Full && !backoff.is_spinning())
+            {
+                channel::Waiter waiter{};
+                channel::WaitNode node{&waiter, 0};
+
+                send_waiters_.enqueue(&node);
+                try
+                {
+                    status = try_send_envelope<U>(value, ack);
+                }
+                catch (...)
+                {
+                    channel::abandon(send_waiters_, node);
+                    throw;
+                }
+                if (status == SendStatus::Full)
+                {
+                    channel::park(waiter);
+                }
+                send_waiters_.remove(&node);
+
+                if (status == SendStatus::Sent && waiter.state_.load(std::memory_order_relaxed) != channel::WAITING_)
+                {
+                    send_waiters_.notify_one();  // the free slot we were woken for is still free
+                }
+            }
+
+            if (status == SendStatus::Sent)
+            {
+                break;
+            }
+            if (status == SendStatus::Closed)
+            {
+                throw std::runtime_error("Send on a closed channel!");
+            }
+            if (backoff.is_spinning())
+            {
+                backoff.pause();
+            }
+        }
+
+        if (ack != nullptr)
+        {
+            wait_delivered(delivered);
+        }
+    }
+
+    // false when the buffer is full (unbuffered: no parked receiver could be claimed, or it declined)
+    template <typename U = T>
+    [[nodiscard]] bool try_send(U&& value) noexcept(false)
+    {
+        if (unbuffered_)
+        {
+            return try_hand_over<U>(value);
+        }
+
+        const SendStatus status = try_send_envelope<U>(value, nullptr);
+
+        if (status == SendStatus::Closed)
+        {
+            throw std::runtime_error("Send on a closed channel!");
+        }
+        return status == SendStatus::Sent;
+    }
+
+    // false once the channel is closed and every value is received
+    [[nodiscard]] bool receive(T& out)
+    {
+        return wait_receive([&out](T&& value) { out = std::move(value); });
+    }
+
+    [[nodiscard]] std::optional<T> receive()
+    {
+        std::optional<T> out{};
+        (void)wait_receive([&out](T&& value) { out.emplace(std::move(value)); });
+        return out;
+    }
+
+    [[nodiscard]] ReceiveStatus try_receive(T& out)
+    {
+        return try_receive_with([&out](T&& value) { out = std::move(value); });
+    }
+
+    void close() noexcept(false)
+    {
+        if ((state_.fetch_or(CLOSED_, std::memory_order_acq_rel) & CLOSED_) != 0)
+        {
+            throw std::runtime_error("Channel is already closed!");
+        }
+
+        // sends that passed the closed check finish their push, then receivers can tell drained from racing
+        erturk::concurrency::lock_free::Backoff backoff{};
+        while (state_.load(std::memory_order_acquire) != CLOSED_)
+        {
+            backoff.pause();
+        }
+
+        receive_waiters_.notify_all();
+        send_waiters_.notify_all();
+    }
+
+    [[nodiscard]] bool is_closed() const noexcept
+    {
+        return (state_.load(std::memory_order_acquire) & CLOSED_) != 0;
+    }
+
+    // 0 for an unbuffered channel
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return unbuffered_ ? 0 : ring_.capacity();
+    }
+
+    // Approximate while other threads use the channel
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return ring_.size();
+    }
+
+private:
+    // Counts a send in flight, false when the channel is closed
+    [[nodiscard]] bool enter_send() noexcept
+    {
+        if ((state_.fetch_add(SENDER_, std::memory_order_acquire) & CLOSED_) != 0)
+        {
+            state_.fetch_sub(SENDER_, std::memory_order_release);
+
+            // a receiver that saw this count took it for a send in flight and may have parked after close's notify
+            receive_waiters_.notify_all();
+            return false;
+        }
+        return true;
+    }
+
+    void leave_send() noexcept
+    {
+        state_.fetch_sub(SENDER_, std::memory_order_release);
+    }
+
+    template <typename U>
+    [[nodiscard]] SendStatus try_send_envelope(std::remove_reference_t<U>& value, std::atomic<uint32_t>* ack)
+    {
+        if (!enter_send())
+        {
+            return SendStatus::Closed;
+        }
+
+        bool sent = false;
+        try
+        {
+            // the value is only moved from when a cell is taken
+            sent = ring_.try_emplace(std::forward<U>(value), ack);
+        }
+        catch (...)
+        {
+            leave_send();
+            throw;
+        }
+        leave_send();
+
+        if (!sent)
+        {
+            return SendStatus::Full;
+        }
+
+        receive_waiters_.notify_one();
+        return SendStatus::Sent;
+    }
+
+    // Unbuffered try_send: the value goes straight to a claimed receiver and is only moved from if that one takes it
+    template <typename U>
+    [[nodiscard]] bool try_hand_over(std::remove_reference_t<U>& value)
+    {
+        using Source = std::remove_reference_t<U>;
+
+        const auto make = [](const void* source, std::optional<T>& out)
+        {
+            out.emplace(std::forward<U>(*static_cast<Source*>(const_cast<void*>(source))));
+        };
+        channel::TypedHandoff<T> handoff{&value, make};
+
+        if (!enter_send())
+        {
+            throw std::runtime_error("Send on a closed channel!");
+        }
+        // counted as in flight until claimed, close waits for it and the claimed receiver takes it even after close
+        const bool claimed = receive_waiters_.claim(&handoff);
+        leave_send();
+
+        if (!claimed)
+        {
+            return false;
+        }
+
+        wait_delivered(handoff.state_);
+        if (handoff.error_ != nullptr)
+        {
+            std::rethrow_exception(handoff.error_);
+        }
+        return handoff.state_.load(std::memory_order_relaxed) == channel::HANDOFF_TAKEN_;
+    }
+
+    // consume (T&&) runs while the ring cell is held, callers only move the value out. If consume throws the value is
+    // dropped (the ring frees its cell), the sender is still released and the exception propagates.
+    template <typename Consume>
+    [[nodiscard]] ReceiveStatus try_receive_with(Consume&& consume)
+    {
+        const auto acknowledge = [](const Envelope& envelope) noexcept
+        {
+            if (envelope.delivered_ != nullptr)
+            {
+                envelope.delivered_->store(1, std::memory_order_release);
+                erturk::concurrency::coordination::futex_wake(*envelope.delivered_, 1);
+            }
+        };
+        const auto take = [&consume, &acknowledge](Envelope&& envelope)
+        {
+            try
+            {
+                consume(std::move(envelope.value_));
+            }
+            catch (...)
+            {
+                acknowledge(envelope);
+                throw;
+            }
+            acknowledge(envelope);
+        };
+
+        try
+        {
+            if (!ring_.try_consume(take))
+            {
+                if (state_.load(std::memory_order_acquire) != CLOSED_)
+                {
+                    return ReceiveStatus::Empty;
+                }
+
+                // closed with no send in flight: every value sent is in the ring, a missing one will never come
+                if (!ring_.try_consume(take))
+                {
+                    return ReceiveStatus::Closed;
+                }
+            }
+        }
+        catch (...)
+        {
+            send_waiters_.notify_one();  // the cell was freed all the same
+            throw;
+        }
+
+        send_waiters_.notify_one();
+        return ReceiveStatus::Received;
+    }
+
+    template <typename Consume>
+    [[nodiscard]] bool wait_receive(Consume&& consume)
+    {
+        erturk::concurrency::lock_free::Backoff backoff{};
+
+        while (true)
+        {
+            ReceiveStatus status = try_receive_with(consume);
+
+            if (status == ReceiveStatus::Empty && !backoff.is_spinning())
+            {
+                channel::Waiter waiter{};
+                channel::WaitNode node{&waiter, 0};
+
+                receive_waiters_.enqueue(&node);
+                try
+                {
+                    status = try_receive_with(consume);
+                }
+                catch (...)
+                {
+                    channel::abandon(receive_waiters_, node);
+                    throw;
+                }
+                if (status == ReceiveStatus::Empty)
+                {
+                    channel::park(waiter);
+                }
+                receive_waiters_.remove(&node);
+
+                if (node.handoff_ != nullptr)
+                {
+                    // claimed by an unbuffered try_send, its value came with the wakeup
+                    if (status == ReceiveStatus::Received)
+                    {
+                        channel::settle(*node.handoff_, channel::HANDOFF_DECLINED_);
+                    }
+                    else if (channel::take_handoff<T>(*node.handoff_, consume))
+                    {
+                        status = ReceiveStatus::Received;
+                    }
+                }
+                else if (status == ReceiveStatus::Received &&
+                         waiter.state_.load(std::memory_order_relaxed) != channel::WAITING_)
+                {
+                    receive_waiters_.notify_one();  // the value we were woken for is still there
+                }
+            }
+
+            if (status != ReceiveStatus::Empty)
+            {
+                return status == ReceiveStatus::Received;
+            }
+            if (backoff.is_spinning())
+            {
+                backoff.pause();
+            }
+        }
+    }
+
+    static void wait_delivered(std::atomic<uint32_t>& delivered) noexcept
+    {
+        erturk::concurrency::lock_free::Backoff backoff{};
+
+        while (delivered.load(std::memory_order_acquire) == 0)
+        {
+            if (backoff.is_spinning())
+            {
+                backoff.pause();
+            }
+            else
+            {
+                erturk::concurrency::coordination::futex_wait(delivered, 0);
+            }
+        }
+    }
+
+private:
+    const bool unbuffered_;
+    alignas(erturk::concurrency::lock_free::CACHE_LINE_SIZE_) std::atomic<uint64_t> state_{0};
+    erturk::concurrency::lock_free::BoundedMpmcQueue<Envelope> ring_;
+    channel::WaitList receive_waiters_{};
+    channel::WaitList send_waiters_{};
+};
+
+template <typename T, typename Handler>
+struct ReceiveCase
+{
+    Channel<T>& channel_;
+    Handler handler_;  // called with T&&
+};
+
+template <typename T, typename Handler>
+[[nodiscard]] ReceiveCase<T, std::decay_t<Handler>> on_receive(Channel<T>& channel, Handler&& handler)
+{
+    return ReceiveCase<T, std::decay_t<Handler>>{channel, std::forward<Handler>(handler)};
+}
+
+namespace channel
+{
+
+struct SelectAccess
+{
+    template <typename T, typename Handler>
+    [[nodiscard]] static ReceiveStatus try_receive(ReceiveCase<T, Handler>& receive_case)
+    {
+        std::optional<T> value{};
+
+        const ReceiveStatus status =
+            receive_case.channel_.try_receive_with([&value](T&& received) { value.emplace(std::move(received)); });
+
+        if (status == ReceiveStatus::Received)
+        {
+            receive_case.handler_(std::move(*value));
+        }
+        return status;
+    }
+
+    template <typename T, typename Handler>
+    [[nodiscard]] static bool take_handoff(ReceiveCase<T, Handler>& receive_case, Handoff& handoff)
+    {
+        return channel::take_handoff<T>(handoff, receive_case.handler_);
+    }
+
+    template <typename T, typename Handler>
+    [[nodiscard]] static WaitList& receive_waiters(ReceiveCase<T, Handler>& receive_case) noexcept
+    {
+        return receive_case.channel_.receive_waiters_;
+    }
+};
+
+// Calls visit on the case at index
+template <typename Cases, typename Visit, size_t... INDEX>
+inline void visit_case(Cases& cases, const size_t index, Visit&& visit, std::index_sequence<INDEX...>)
+{
+    ((INDEX == index ? (void)visit(std::get<INDEX>(cases)) : void()), ...);
+}
+
+template <typename Cases>
+[[nodiscard]] inline WaitList& case_waiters(Cases& cases, const size_t index) noexcept
+{
+    WaitList* waiters = nullptr;
+
+    visit_case(
+        cases, index, [&waiters](auto& receive_case) { waiters = &SelectAccess::receive_waiters(receive_case); },
+        std::make_index_sequence<std::tuple_size_v<Cases>>{});
+    return *waiters;
+}
+
+template <typename Cases>
+[[nodiscard]] inline bool take_case_handoff(Cases& cases, const size_t index, Handoff& handoff)
+{
+    bool taken = false;
+
+    visit_case(
+        cases, index, [&](auto& receive_case) { taken = SelectAccess::take_handoff(receive_case, handoff); },
+        std::make_index_sequence<std::tuple_size_v<Cases>>{});
+    return taken;
+}
+
+template <typename Cases>
+[[nodiscard]] inline size_t try_select_cases(Cases& cases)
+{
+    constexpr size_t CASE_COUNT = std::tuple_size_v<Cases>;
+    thread_local size_t rotation = 0;
+
+    const size_t start = rotation++ % CASE_COUNT;
+    bool all_closed = true;
+
+    for (size_t step = 0; step < CASE_COUNT; step++)
+    {
+        const size_t index = (start + step) % CASE_COUNT;
+        ReceiveStatus status = ReceiveStatus::Empty;
+
+        visit_case(
+            cases, index, [&status](auto& receive_case) { status = SelectAccess::try_receive(receive_case); },
+            std::make_index_sequence<CASE_COUNT>{});
+
+        if (status == ReceiveStatus::Received)
+        {
+            return index;
+        }
+        all_closed = all_closed && status == ReceiveStatus::Closed;
+    }
+    return all_closed ? SELECT_CLOSED_ : SELECT_NONE_;
+}
+
+}  // namespace channel
+
+/**
+ *  @brief  Receives from the first ready channel without blocking and runs its handler.
+ *  @return The index of that case, SELECT_NONE_ when nothing is ready, SELECT_CLOSED_ when every channel is closed.
+ */
+template <typename... Cases>
+[[nodiscard]] size_t try_select(Cases&&... cases)
+{
+    static_assert(sizeof...(Cases) > 0, "Select needs at least one case!");
+
+    std::tuple<Cases&...> case_refs{cases...};
+    return channel::try_select_cases(case_refs);
+}
+
+/**
+ *  @brief  Blocks until one channel delivers and runs its handler.
+ *  @return The index of that case, SELECT_CLOSED_ once every channel is closed and drained.
+ */
+template <typename... Cases>
+[[nodiscard]] size_t select(Cases&&... cases)
+{
+    static_assert(sizeof...(Cases) > 0, "Select needs at least one case!");
+
+    constexpr size_t CASE_COUNT = sizeof...(Cases);
+    std::tuple<Cases&...> case_refs{cases...};
+    erturk::concurrency::lock_free::Backoff backoff{};
+
+    while (true)
+    {
+        size_t result = channel::try_select_cases(case_refs);
+
+        if (result != SELECT_NONE_)
+        {
+            return result;
+        }
+        if (backoff.is_spinning())
+        {
+            backoff.pause();
+            continue;
+        }
+
+        channel::Waiter waiter{};
+        std::array<channel::WaitNode, CASE_COUNT> nodes{};
+
+        for (size_t index = 0; index < CASE_COUNT; index++)
+        {
+            nodes[index] = channel::WaitNode{&waiter, static_cast<uint32_t>(index)};
+            channel::case_waiters(case_refs, index).enqueue(&nodes[index]);
+        }
+
+        bool handed = false;  // the wakeup came from an unbuffered try_send's claim, not with a value in the ring
+
+        try
+        {
+            result = channel::try_select_cases(case_refs);
+            if (result == SELECT_NONE_)
+            {
+                channel::park(waiter);
+            }
+
+            for (size_t index = 0; index < CASE_COUNT; index++)
+            {
+                channel::case_waiters(case_refs, index).remove(&nodes[index]);
+            }
+
+            const uint32_t state = waiter.state_.load(std::memory_order_acquire);
+            if (state != channel::WAITING_ && nodes[state - 1].handoff_ != nullptr)
+            {
+                channel::Handoff* handoff = std::exchange(nodes[state - 1].handoff_, nullptr);
+                handed = true;
+
+                if (result != SELECT_NONE_ && result != SELECT_CLOSED_)
+                {
+                    channel::settle(*handoff, channel::HANDOFF_DECLINED_);
+                }
+                else if (channel::take_case_handoff(case_refs, state - 1, *handoff))
+                {
+                    result = state - 1;
+                }
+            }
+
+            if (result == SELECT_NONE_)
+            {
+                result = channel::try_select_cases(case_refs);
+            }
+        }
+        catch (...)
+        {
+            // a handler threw: unlink every node (no-op for unlinked ones), pass on a wakeup one of them took
+            for (size_t index = 0; index < CASE_COUNT; index++)
+            {
+                channel::case_waiters(case_refs, index).remove(&nodes[index]);
+            }
+            const uint32_t state = waiter.state_.load(std::memory_order_acquire);
+            if (state != channel::WAITING_ && nodes[state - 1].handoff_ != nullptr)
+            {
+                channel::settle(*nodes[state - 1].handoff_, channel::HANDOFF_DECLINED_);
+            }
+            else if (state != channel::WAITING_ && !handed)
+            {
+                channel::case_waiters(case_refs, state - 1).notify_one();
+            }
+            throw;
+        }
+
+        // woken by a channel whose value we did not take: wake the next receiver of that channel
+        const uint32_t state = waiter.state_.load(std::memory_order_acquire);
+        if (state != channel::WAITING_ && !handed && result != SELECT_NONE_ && result != state - 1)
+        {
+            channel::case_waiters(case_refs, state - 1).notify_one();
+        }
+
+        if (result != SELECT_NONE_)
+        {
+            return result;
+        }
+    }
+}
+
+}  // namespace erturk::communication
+
+#endif  // ERTURK_CHANNEL_H
@@ -0,0 +1,84 @@
+#ifndef ERTURK_EVENT_COUNT_H
+#define ERTURK_EVENT_COUNT_H
+
+#include "Futex.hpp"
+#include <atomic>
+#include <cstdint>
+
+/*
+Event count: lets a thread sleep on "some condition became true" without a mutex around the condition.
+
+  const uint32_t key = events.prepare_wait();
+  if (condition()) events.cancel_wait();   // re-check after announcing the wait
+  else events.wait(key);
+
+  make_condition_true(); events.notify_one();
+
+prepare_wait announces the waiter before the re-check, notify checks for waiters after the change (both behind a
+seq_cst fence): either the re-check sees the change or the notifier sees the waiter and bumps epoch_, then the
+futex sleep on the old key returns at once. A notify with no waiter is a fence and a load, no syscall.
+*/
+namespace erturk::concurrency::coordination
+{
+
+class EventCount final
+{
+public:
+    [[nodiscard]] uint32_t prepare_wait() noexcept
+    {
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_relaxed);
+    }
+
+    void cancel_wait() noexcept
+    {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Sleeps until a notify after prepare_wait returned key
+    void wait(const uint32_t key) noexcept
+    {
+        while (epoch_.load(std::memory_order_acquire) == key)
+        {
+            futex_wait(epoch_, key);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_one() noexcept
+    {
+        notify(1);
+    }
+
+    void notify_all() noexcept
+    {
+        notify(FUTEX_WAKE_ALL_);
+    }
+
+    [[nodiscard]] bool has_waiters() const noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return waiters_.load(std::memory_order_relaxed) != 0;
+    }
+
+private:
+    void notify(const int count) noexcept
+    {
+        if (!has_waiters())
+        {
+            return;
+        }
+
+        epoch_.fetch_add(1, std::memory_order_release);
+        futex_wake(epoch_, count);
+    }
+
+private:
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> waiters_{0};
+};
+
+}  // namespace erturk::concurrency::coordination
+
+#endif  // ERTURK_EVENT_COUNT_H
@@ -0,0 +1,41 @@
+#ifndef ERTURK_FUTEX_H
+#define ERTURK_FUTEX_H
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+/*
+Thin wrappers over the Linux futex syscall (process private), the parking primitive of the blocking paths.
+
+futex_wait sleeps only while the word still holds expected, the check and the sleep are atomic in the kernel, so a
+wake between the caller's last load and the sleep is never lost. Wakers change the word first, then call futex_wake.
+Both return on spurious wakeups and signals too, callers loop on their own condition.
+
+Unlike std::atomic::notify_*, futex_wake may be called on a word whose owner has already returned (the address is
+only a key in the kernel): a waiter's word can live on its stack and the waker does not have to outlive it.
+*/
+namespace erturk::concurrency::coordination
+{
+
+inline constexpr int FUTEX_WAKE_ALL_ = INT_MAX;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be a plain 32 bit integer!");
+
+inline void futex_wait(std::atomic<uint32_t>& word, const uint32_t expected) noexcept
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+// Wakes up to count threads sleeping on word
+inline void futex_wake(std::atomic<uint32_t>& word, const int count) noexcept
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+}  // namespace erturk::concurrency::coordination
+
+#endif  // ERTURK_FUTEX_H
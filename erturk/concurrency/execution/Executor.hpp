@@ -0,0 +1,115 @@
+#ifndef ERTURK_EXECUTOR_H
+#define ERTURK_EXECUTOR_H
+
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <thread>
+
+/*
+Executors run bulk work: bulk(count, function) calls function(index) for every index in [0, count) and returns when
+all calls are done, the first exception of a call is rethrown. concurrency() tells how many calls may run at once,
+callers size their chunks from it.
+
+- SequentialExecutor : every call on the calling thread, in index order.
+- PoolExecutor       : calls as tasks of a WorkStealingPool. The index range is split in halves recursively, each
+                       split hands the upper half to the pool, so idle workers steal large ranges instead of
+                       single calls and the calling thread works on the lowest indices (and helps in wait).
+
+default_executor() is a PoolExecutor over a process wide pool with one worker less than hardware threads (the
+calling thread takes part in bulk), created on first use and never destroyed (its workers park when idle).
+*/
+namespace erturk::concurrency::execution
+{
+
+template <class E>
+concept Executor = requires(const E& executor, const size_t count, void (*function)(size_t)) {
+    {
+        executor.concurrency()
+    } -> std::convertible_to<size_t>;
+    executor.bulk(count, function);
+};
+
+class SequentialExecutor final
+{
+public:
+    [[nodiscard]] constexpr size_t concurrency() const noexcept
+    {
+        return 1;
+    }
+
+    template <typename Function>
+    void bulk(const size_t count, Function&& function) const
+    {
+        for (size_t index = 0; index < count; index++)
+        {
+            function(index);
+        }
+    }
+};
+
+class PoolExecutor final
+{
+public:
+    explicit PoolExecutor(WorkStealingPool& pool) noexcept : pool_{&pool}
+    {
+    }
+
+    // The workers plus the calling thread, which runs tasks while it waits
+    [[nodiscard]] size_t concurrency() const noexcept
+    {
+        return pool_->current_index() == work_stealing::EXTERNAL_THREAD_ ? pool_->worker_count() + 1
+                                                                         : pool_->worker_count();
+    }
+
+    template <typename Function>
+    void bulk(const size_t count, Function&& function) const noexcept(false)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count == 1)
+        {
+            function(0);
+            return;
+        }
+
+        TaskGroup group{*pool_};
+        split(group, 0, count, function);
+        group.wait();
+    }
+
+    [[nodiscard]] WorkStealingPool& pool() const noexcept
+    {
+        return *pool_;
+    }
+
+private:
+    template <typename Function>
+    static void split(TaskGroup& group, const size_t first, size_t last, Function& function)
+    {
+        while (last - first > 1)
+        {
+            const size_t middle = first + (last - first) / 2;
+            group.run([&group, middle, last, &function] { split(group, middle, last, function); });
+            last = middle;
+        }
+        function(first);
+    }
+
+private:
+    WorkStealingPool* pool_;
+};
+
+// Never destroyed, the pool's workers may still be parked when static destruction runs
+[[nodiscard]] inline PoolExecutor default_executor() noexcept(false)
+{
+    static WorkStealingPool* pool = new WorkStealingPool{std::max(2U, std::thread::hardware_concurrency()) - 1};
+    return PoolExecutor{*pool};
+}
+
+}  // namespace erturk::concurrency::execution
+
+#endif  // ERTURK_EXECUTOR_H
@@ -0,0 +1,470 @@
+#ifndef ERTURK_WORK_STEALING_POOL_H
+#define ERTURK_WORK_STEALING_POOL_H
+
+#include "../coordination/EventCount.hpp"
+#include "../coordination/Futex.hpp"
+#include "../lock_free/Backoff.hpp"
+#include "../lock_free/ChaseLevDeque.hpp"
+#include "../lock_free/MpscQueue.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Work-stealing thread pool for fine grained fork/join tasks.
+
+- Every worker owns a Chase-Lev deque: tasks submitted from a worker go to the bottom of its own deque and are popped
+  from there (LIFO, hot in cache), no shared counter or lock is touched.
+- An idle worker steals from the top of other deques (oldest, usually largest tasks), starting at a random victim so
+  thieves spread instead of all hitting worker 0.
+- Submissions from outside the pool go to one injection queue (IntrusiveMpscQueue, workers take turns as its
+  consumer through a try-lock flag).
+- A worker without work spins (Backoff), then parks on an EventCount (futex). Submitting checks for parked workers
+  after a fence, a busy pool pays no syscall. A worker that found work wakes one more sleeper while others sleep, so
+  a burst spreads over the pool.
+- pin_workers binds worker i to the i-th CPU the process may run on (best effort).
+
+Tasks are heap allocated closures, a task must not throw: TaskGroup::run captures exceptions and rethrows them from
+wait. The destructor runs every task already submitted (tasks may still submit), then joins the workers.
+
+  WorkStealingPool pool{};
+  TaskGroup group{pool};
+  group.run([&] { left(); });
+  right();
+  group.wait();  // runs pending tasks while waiting
+*/
+namespace erturk::concurrency::execution
+{
+
+struct Task : erturk::concurrency::lock_free::MpscObject
+{
+    void (*execute_)(Task*) noexcept;  // runs and deletes the task
+};
+
+class WorkStealingPool;
+
+namespace work_stealing
+{
+
+inline constexpr size_t EXTERNAL_THREAD_ = SIZE_MAX;
+
+template <typename Function>
+struct FunctionTask final : Task
+{
+    explicit FunctionTask(Function&& function) : Task{{}, &FunctionTask::execute}, function_{std::move(function)}
+    {
+    }
+
+    explicit FunctionTask(const Function& function) : Task{{}, &FunctionTask::execute}, function_{function}
+    {
+    }
+
+    static void execute(Task* task) noexcept
+    {
+        std::unique_ptr<FunctionTask> self{static_cast<FunctionTask*>(task)};
+        self->function_();
+    }
+
+    Function function_;
+};
+
+struct alignas(erturk::concurrency::lock_free::CACHE_LINE_SIZE_) Worker
+{
+    erturk::concurrency::lock_free::ChaseLevDeque<Task*> deque_{};
+    uint64_t random_state_{0};
+};
+
+struct WorkerContext
+{
+    const WorkStealingPool* pool_;
+    size_t index_;
+};
+
+inline thread_local WorkerContext current_worker_{nullptr, EXTERNAL_THREAD_};
+
+[[nodiscard]] inline uint64_t next_random(uint64_t& state) noexcept
+{
+    // xorshift64, the state must not be 0
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// The index-th CPU of the process affinity mask, best effort
+inline void pin_to_cpu(std::thread& thread, const size_t index) noexcept
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0)
+    {
+        return;
+    }
+
+    size_t remaining = index % static_cast<size_t>(CPU_COUNT(&allowed));
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &allowed) && remaining-- == 0)
+        {
+            cpu_set_t target;
+            CPU_ZERO(&target);
+            CPU_SET(cpu, &target);
+            ::pthread_setaffinity_np(thread.native_handle(), sizeof(target), &target);
+            return;
+        }
+    }
+}
+
+}  // namespace work_stealing
+
+class WorkStealingPool final
+{
+public:
+    explicit WorkStealingPool(const size_t worker_count = std::max(1U, std::thread::hardware_concurrency()),
+                              const bool pin_workers = false) noexcept(false)
+        : worker_count_{std::max<size_t>(1, worker_count)},
+          workers_{std::make_unique<work_stealing::Worker[]>(worker_count_)}
+    {
+        threads_.reserve(worker_count_);
+        try
+        {
+            for (size_t index = 0; index < worker_count_; index++)
+            {
+                workers_[index].random_state_ = 0x9E3779B97F4A7C15ULL * (index + 1);
+                threads_.emplace_back(&WorkStealingPool::worker_loop, this, index);
+
+                if (pin_workers)
+                {
+                    work_stealing::pin_to_cpu(threads_.back(), index);
+                }
+            }
+        }
+        catch (...)
+        {
+            stop();  // the destructor does not run for a throwing constructor
+            throw;
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool()
+    {
+        stop();
+    }
+
+    // Any thread, function runs exactly once on a worker (or on a thread helping in run_pending)
+    template <typename Function>
+    void submit(Function&& function) noexcept(false)
+    {
+        schedule(new work_stealing::FunctionTask<std::decay_t<Function>>{std::forward<Function>(function)});
+    }
+
+    // Runs one pending task on the calling thread, false when none was found
+    bool run_pending() noexcept
+    {
+        Task* task = find_task(current_index());
+
+        if (task == nullptr)
+        {
+            return false;
+        }
+        task->execute_(task);
+        return true;
+    }
+
+    [[nodiscard]] size_t worker_count() const noexcept
+    {
+        return worker_count_;
+    }
+
+    // Index of the calling worker of this pool, EXTERNAL_THREAD_ for any other thread
+    [[nodiscard]] size_t current_index() const noexcept
+    {
+        return work_stealing::current_worker_.pool_ == this ? work_stealing::current_worker_.index_
+                                                            : work_stealing::EXTERNAL_THREAD_;
+    }
+
+private:
+    void schedule(Task* task) noexcept(false)
+    {
+        const size_t index = current_index();
+
+        if (index != work_stealing::EXTERNAL_THREAD_)
+        {
+            workers_[index].deque_.push(task);
+        }
+        else
+        {
+            injected_.fetch_add(1, std::memory_order_relaxed);
+            injection_.push(task);
+        }
+        idle_.notify_one();
+    }
+
+    [[nodiscard]] Task* take_injected() noexcept
+    {
+        if (injected_.load(std::memory_order_relaxed) == 0 ||
+            injection_consumer_.exchange(true, std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        Task* task = injection_.try_pop();
+        injection_consumer_.store(false, std::memory_order_release);
+
+        if (task != nullptr)
+        {
+            injected_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    [[nodiscard]] Task* steal(const size_t self) noexcept
+    {
+        thread_local uint64_t external_random_state = 0x2545F4914F6CDD1DULL;
+        uint64_t& random_state =
+            self != work_stealing::EXTERNAL_THREAD_ ? workers_[self].random_state_ : external_random_state;
+
+        const size_t start = work_stealing::next_random(random_state) % worker_count_;
+        Task* task = nullptr;
+
+        for (size_t step = 0; step < worker_count_; step++)
+        {
+            const size_t victim = (start + step) % worker_count_;
+            if (victim == self)
+            {
+                continue;
+            }
+
+            erturk::concurrency::lock_free::StealStatus status;
+            while ((status = workers_[victim].deque_.steal(task)) == erturk::concurrency::lock_free::StealStatus::Lost)
+            {
+                erturk::concurrency::lock_free::cpu_relax();
+            }
+
+            if (status == erturk::concurrency::lock_free::StealStatus::Stolen)
+            {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] Task* find_task(const size_t self) noexcept
+    {
+        Task* task = nullptr;
+
+        if (self != work_stealing::EXTERNAL_THREAD_ && workers_[self].deque_.pop(task))
+        {
+            return task;
+        }
+
+        task = take_injected();
+        if (task == nullptr)
+        {
+            task = steal(self);
+        }
+
+        if (task != nullptr && has_work())
+        {
+            idle_.notify_one();  // more where this came from, wake a sleeper to share it
+        }
+        return task;
+    }
+
+    // Lets the started workers drain and return, then joins them
+    void stop() noexcept
+    {
+        stopping_.store(true, std::memory_order_release);
+        idle_.notify_all();
+
+        for (std::thread& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    [[nodiscard]] bool has_work() const noexcept
+    {
+        if (injected_.load(std::memory_order_relaxed) != 0)
+        {
+            return true;
+        }
+
+        for (size_t index = 0; index < worker_count_; index++)
+        {
+            if (!workers_[index].deque_.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(const size_t index) noexcept
+    {
+        work_stealing::current_worker_ = work_stealing::WorkerContext{this, index};
+        erturk::concurrency::lock_free::Backoff backoff{};
+
+        while (true)
+        {
+            Task* task = find_task(index);
+
+            if (task != nullptr)
+            {
+                task->execute_(task);
+                backoff.reset();
+                continue;
+            }
+
+            if (backoff.is_spinning())
+            {
+                backoff.pause();
+                continue;
+            }
+
+            const uint32_t key = idle_.prepare_wait();
+            if (has_work())
+            {
+                idle_.cancel_wait();
+            }
+            else if (stopping_.load(std::memory_order_acquire))
+            {
+                idle_.cancel_wait();
+                return;  // drained
+            }
+            else
+            {
+                idle_.wait(key);
+            }
+            backoff.reset();
+        }
+    }
+
+private:
+    const size_t worker_count_;
+    std::unique_ptr<work_stealing::Worker[]> workers_;
+    std::vector<std::thread> threads_{};
+
+    alignas(erturk::concurrency::lock_free::CACHE_LINE_SIZE_) std::atomic<size_t> injected_{0};
+    std::atomic<bool> injection_consumer_{false};
+    erturk::concurrency::lock_free::IntrusiveMpscQueue<Task> injection_{};
+
+    alignas(erturk::concurrency::lock_free::CACHE_LINE_SIZE_) erturk::concurrency::coordination::EventCount idle_{};
+    std::atomic<bool> stopping_{false};
+};
+
+// Fork/join scope: run submits to the pool, wait helps running pending tasks until every task of the group is done
+class TaskGroup final
+{
+public:
+    explicit TaskGroup(WorkStealingPool& pool) noexcept : pool_{pool}
+    {
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        wait_done();
+    }
+
+    template <typename Function>
+    void run(Function&& function) noexcept(false)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+
+        try
+        {
+            pool_.submit(
+                [this, function = std::forward<Function>(function)]() mutable noexcept
+                {
+                    try
+                    {
+                        function();
+                    }
+                    catch (...)
+                    {
+                        if (!failed_.exchange(true, std::memory_order_relaxed))
+                        {
+                            exception_ = std::current_exception();
+                        }
+                    }
+                    finish();
+                });
+        }
+        catch (...)
+        {
+            finish();
+            throw;
+        }
+    }
+
+    // Rethrows the first exception of a task
+    void wait() noexcept(false)
+    {
+        wait_done();
+
+        if (failed_.load(std::memory_order_relaxed))
+        {
+            failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+    }
+
+private:
+    void finish() noexcept
+    {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            erturk::concurrency::coordination::futex_wake(pending_, erturk::concurrency::coordination::FUTEX_WAKE_ALL_);
+        }
+    }
+
+    void wait_done() noexcept
+    {
+        erturk::concurrency::lock_free::Backoff backoff{};
+        uint32_t pending = 0;
+
+        while ((pending = pending_.load(std::memory_order_acquire)) != 0)
+        {
+            if (pool_.run_pending())
+            {
+                backoff.reset();
+            }
+            else if (backoff.is_spinning())
+            {
+                backoff.pause();
+            }
+            else
+            {
+                // tasks of the group run elsewhere, the last one to finish wakes us
+                erturk::concurrency::coordination::futex_wait(pending_, pending);
+            }
+        }
+    }
+
+private:
+    WorkStealingPool& pool_;
+    std::atomic<uint32_t> pending_{0};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr exception_{};
+};
+
+}  // namespace erturk::concurrency::execution
+
+#endif  // ERTURK_WORK_STEALING_POOL_H
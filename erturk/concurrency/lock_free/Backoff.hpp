@@ -0,0 +1,70 @@
+#ifndef ERTURK_BACKOFF_H
+#define ERTURK_BACKOFF_H
+
+#include <sched.h>
+#include <cstddef>
+#include <cstdint>
+
+/*
+Spin waiting for lock-free retry loops.
+
+cpu_relax hints the core that the thread spins (x86 pause, arm yield): the sibling hyper-thread gets the pipeline and
+leaving the loop does not flush it. Backoff doubles the pause count on every failed attempt up to SPIN_LIMIT_ pauses,
+then yields the time slice, callers that can block switch to a futex/atomic wait once is_spinning() is false.
+*/
+namespace erturk::concurrency::lock_free
+{
+
+// Padding unit that keeps independently written atomics off each other's cache line
+inline constexpr size_t CACHE_LINE_SIZE_ = 64;
+
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    asm volatile("" ::: "memory");
+#endif
+}
+
+class Backoff
+{
+public:
+    static constexpr uint32_t SPIN_LIMIT_ = 64;  // pauses of the longest spin round
+
+    void pause() noexcept
+    {
+        if (spins_ <= SPIN_LIMIT_)
+        {
+            for (uint32_t idx = 0; idx < spins_; idx++)
+            {
+                cpu_relax();
+            }
+            spins_ *= 2;
+        }
+        else
+        {
+            ::sched_yield();
+        }
+    }
+
+    // Still in the spinning phase, afterwards pause() yields
+    [[nodiscard]] bool is_spinning() const noexcept
+    {
+        return spins_ <= SPIN_LIMIT_;
+    }
+
+    void reset() noexcept
+    {
+        spins_ = 1;
+    }
+
+private:
+    uint32_t spins_{1};
+};
+
+}  // namespace erturk::concurrency::lock_free
+
+#endif  // ERTURK_BACKOFF_H
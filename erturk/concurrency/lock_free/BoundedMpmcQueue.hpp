@@ -0,0 +1,450 @@
+#ifndef ERTURK_BOUNDED_MPMC_QUEUE_H
+#define ERTURK_BOUNDED_MPMC_QUEUE_H
+
+#include "../../memory/TypeBufferMemory.hpp"
+#include "Backoff.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+Bounded multi-producer multi-consumer queue (Vyukov): a power of two ring of cells, each cell carries a sequence
+number that tells whose turn it is.
+
+- cell.sequence_ == pos     : free for the producer of position pos
+- cell.sequence_ == pos + 1 : holds the element of position pos, for its consumer
+- after the pop             : pos + capacity, free for the producer of the next lap
+
+A producer claims a position with one CAS on enqueue_pos_, writes the element and publishes it with a release store of
+the sequence, a consumer mirrors it on dequeue_pos_. Producers and consumers only meet on the cell they hand over, the
+two positions live on their own cache lines. No allocation after construction, no ABA (positions never repeat).
+
+- try_push / try_pop             : fail instead of waiting on a full / empty queue.
+- push / pop                     : spin with backoff, then sleep on the cell's sequence (atomic wait) until it turns.
+- try_push_bulk / try_pop_bulk   : claim every consecutive ready cell (up to count) with a single CAS.
+
+A claimed position can not be given back, so exceptions never leave its cell stuck. If constructing the element
+throws, the cell is handed to its consumer marked empty (consumers skip it) and the exception propagates. If moving
+the element out (or a try_consume callback) throws, the element is destroyed, the cell is freed for the next lap and
+the exception propagates: that element is lost.
+*/
+namespace erturk::concurrency::lock_free
+{
+
+template <typename T>
+class BoundedMpmcQueue final
+{
+    struct Cell
+    {
+        std::atomic<size_t> sequence_;
+        bool holds_element_;  // false when the producer's construction threw
+        alignas(T) unsigned char storage_[sizeof(T)];
+
+        [[nodiscard]] T* element() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage_));
+        }
+    };
+
+public:
+    // capacity is rounded up to a power of two (at least 2)
+    explicit BoundedMpmcQueue(const size_t capacity) noexcept(false)
+        : capacity_{ring_capacity(capacity)}, mask_{capacity_ - 1}
+    {
+        cells_ = static_cast<Cell*>(::operator new(capacity_ * sizeof(Cell), std::align_val_t{alignof(Cell)}));
+
+        for (size_t idx = 0; idx < capacity_; idx++)
+        {
+            new (&cells_[idx].sequence_) std::atomic<size_t>{idx};
+        }
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    ~BoundedMpmcQueue()
+    {
+        // destroy what is left, no thread may use the queue anymore
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); is_ready(pos); pos++)
+        {
+            Cell& cell = cells_[pos & mask_];
+            if (cell.holds_element_)
+            {
+                erturk::type_buffer_memory::destruct_at(cell.element());
+            }
+        }
+
+        ::operator delete(cells_, std::align_val_t{alignof(Cell)});
+    }
+
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args)
+    {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = cells_[pos & mask_];
+            const size_t sequence = cell.sequence_.load(std::memory_order_acquire);
+            const intptr_t turn = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (turn == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    publish(cell, pos, std::forward<Args>(args)...);
+                    return true;
+                }
+            }
+            else if (turn < 0)
+            {
+                return false;  // full: the cell still holds the element of the previous lap
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] bool try_push(const T& value)
+    {
+        return try_emplace(value);
+    }
+
+    [[nodiscard]] bool try_push(T&& value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    [[nodiscard]] bool try_pop(T& out)
+    {
+        return try_consume([&out](T&& element) { out = std::move(element); });
+    }
+
+    // Hands the front element to consume (T&&) while its cell is held, keep consume short (e.g. a move)
+    template <typename Consume>
+    [[nodiscard]] bool try_consume(Consume&& consume)
+    {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = cells_[pos & mask_];
+            const size_t sequence = cell.sequence_.load(std::memory_order_acquire);
+            const intptr_t turn = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+            if (turn == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    if (take(cell, pos, consume))
+                    {
+                        return true;
+                    }
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);  // skipped an empty cell
+                }
+            }
+            else if (turn < 0)
+            {
+                return false;  // empty
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Waits for a free cell
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        // a claimed position is waited for, not given up: no other producer can take it
+        const size_t pos = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+
+        wait_for(cell, pos);
+        publish(cell, pos, std::forward<Args>(args)...);
+    }
+
+    void push(const T& value)
+    {
+        emplace(value);
+    }
+
+    void push(T&& value)
+    {
+        emplace(std::move(value));
+    }
+
+    // Waits for an element
+    void pop(T& out)
+    {
+        const auto assign = [&out](T&& element) { out = std::move(element); };
+
+        while (true)
+        {
+            const size_t pos = dequeue_pos_.fetch_add(1, std::memory_order_relaxed);
+            Cell& cell = cells_[pos & mask_];
+
+            wait_for(cell, pos + 1);
+            if (take(cell, pos, assign))
+            {
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] T pop()
+    {
+        T out{};
+        pop(out);
+        return out;
+    }
+
+    /**
+     *  @brief  Pushes up to count elements from first with one CAS, stops at the first cell that is not free.
+     *  @return The number of elements pushed, elements are moved when first is a move iterator.
+     *  If an element's construction throws, the elements before it stay pushed and the exception propagates.
+     */
+    template <typename InputIt>
+    [[nodiscard]] size_t try_push_bulk(InputIt first, const size_t count)
+    {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t ready = 0;
+
+        do
+        {
+            ready = 0;
+            while (ready < count && cells_[(pos + ready) & mask_].sequence_.load(std::memory_order_acquire) ==
+                                        pos + ready)
+            {
+                ready++;
+            }
+
+            if (ready == 0)
+            {
+                return 0;
+            }
+        } while (!enqueue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed));
+
+        // every claimed cell was seen free, no other producer holds a position of the range
+        size_t idx = 0;
+        try
+        {
+            for (; idx < ready; idx++, ++first)
+            {
+                publish(cells_[(pos + idx) & mask_], pos + idx, *first);
+            }
+        }
+        catch (...)
+        {
+            for (idx++; idx < ready; idx++)
+            {
+                hand_over_empty(cells_[(pos + idx) & mask_], pos + idx);
+            }
+            throw;
+        }
+        return ready;
+    }
+
+    /**
+     *  @brief  Pops up to max_count elements into out with one CAS, stops at the first cell without element.
+     *  @return The number of elements popped.
+     *  If assigning to out throws, the rest of the claimed elements are destroyed and the exception propagates.
+     */
+    template <typename OutputIt>
+    [[nodiscard]] size_t try_pop_bulk(OutputIt out, const size_t max_count)
+    {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t ready = 0;
+
+        do
+        {
+            ready = 0;
+            while (ready < max_count && cells_[(pos + ready) & mask_].sequence_.load(std::memory_order_acquire) ==
+                                            pos + ready + 1)
+            {
+                ready++;
+            }
+
+            if (ready == 0)
+            {
+                return 0;
+            }
+        } while (!dequeue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed));
+
+        const auto assign = [&out](T&& element)
+        {
+            *out = std::move(element);
+            ++out;
+        };
+
+        size_t popped = 0;
+        size_t idx = 0;
+        try
+        {
+            for (; idx < ready; idx++)
+            {
+                popped += take(cells_[(pos + idx) & mask_], pos + idx, assign) ? 1 : 0;
+            }
+        }
+        catch (...)
+        {
+            for (idx++; idx < ready; idx++)
+            {
+                discard(cells_[(pos + idx) & mask_], pos + idx);
+            }
+            throw;
+        }
+        return popped;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // Approximate while other threads push or pop
+    [[nodiscard]] size_t size() const noexcept
+    {
+        const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_relaxed);
+        const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+private:
+    // Validated before bit_ceil, which is undefined past the largest power of two, and before the cell bytes are
+    // computed, which must not wrap
+    [[nodiscard]] static size_t ring_capacity(const size_t capacity) noexcept(false)
+    {
+        if (capacity > (size_t{1} << (sizeof(size_t) * 8 - 2)))
+        {
+            throw std::runtime_error("Queue capacity is too large!");
+        }
+
+        const size_t rounded = capacity < 2 ? 2 : std::bit_ceil(capacity);
+        if (rounded > SIZE_MAX / sizeof(Cell))
+        {
+            throw std::runtime_error("Queue capacity is too large!");
+        }
+        return rounded;
+    }
+
+    template <typename... Args>
+    void publish(Cell& cell, const size_t pos, Args&&... args)
+    {
+        try
+        {
+            erturk::type_buffer_memory::construct_at(reinterpret_cast<T*>(cell.storage_),
+                                                     std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            hand_over_empty(cell, pos);
+            throw;
+        }
+
+        cell.holds_element_ = true;
+        cell.sequence_.store(pos + 1, std::memory_order_release);
+        cell.sequence_.notify_all();
+    }
+
+    // The consumer of pos skips the cell instead of waiting for an element that never comes
+    void hand_over_empty(Cell& cell, const size_t pos) noexcept
+    {
+        cell.holds_element_ = false;
+        cell.sequence_.store(pos + 1, std::memory_order_release);
+        cell.sequence_.notify_all();
+    }
+
+    // Hands the element to consume, false for an empty cell. The cell is released even when consume throws.
+    template <typename Consume>
+    [[nodiscard]] bool take(Cell& cell, const size_t pos, Consume& consume)
+    {
+        if (!cell.holds_element_)
+        {
+            release(cell, pos);
+            return false;
+        }
+
+        T* element = cell.element();
+        try
+        {
+            consume(std::move(*element));
+        }
+        catch (...)
+        {
+            erturk::type_buffer_memory::destruct_at(element);
+            release(cell, pos);
+            throw;
+        }
+
+        erturk::type_buffer_memory::destruct_at(element);
+        release(cell, pos);
+        return true;
+    }
+
+    void discard(Cell& cell, const size_t pos) noexcept
+    {
+        if (cell.holds_element_)
+        {
+            erturk::type_buffer_memory::destruct_at(cell.element());
+        }
+        release(cell, pos);
+    }
+
+    // The cell is free for the producer of the next lap
+    void release(Cell& cell, const size_t pos) noexcept
+    {
+        cell.sequence_.store(pos + capacity_, std::memory_order_release);
+        cell.sequence_.notify_all();
+    }
+
+    void wait_for(Cell& cell, const size_t sequence) noexcept
+    {
+        Backoff backoff{};
+        size_t current = cell.sequence_.load(std::memory_order_acquire);
+
+        while (current != sequence)
+        {
+            if (backoff.is_spinning())
+            {
+                backoff.pause();
+            }
+            else
+            {
+                cell.sequence_.wait(current, std::memory_order_acquire);
+            }
+            current = cell.sequence_.load(std::memory_order_acquire);
+        }
+    }
+
+    [[nodiscard]] bool is_ready(const size_t pos) const noexcept
+    {
+        return cells_[pos & mask_].sequence_.load(std::memory_order_acquire) == pos + 1;
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE_) std::atomic<size_t> enqueue_pos_{0};
+    alignas(CACHE_LINE_SIZE_) std::atomic<size_t> dequeue_pos_{0};
+    alignas(CACHE_LINE_SIZE_) const size_t capacity_;
+    const size_t mask_;
+    Cell* cells_;
+};
+
+}  // namespace erturk::concurrency::lock_free
+
+#endif  // ERTURK_BOUNDED_MPMC_QUEUE_H
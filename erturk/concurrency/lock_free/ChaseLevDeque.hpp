@@ -0,0 +1,194 @@
+#ifndef ERTURK_CHASE_LEV_DEQUE_H
+#define ERTURK_CHASE_LEV_DEQUE_H
+
+#include "Backoff.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*
+Chase-Lev work-stealing deque (the C11 formulation of Le, Pop, Cohen, Zappa Nardelli): one owner pushes and pops at
+the bottom like a stack, any number of thieves steal from the top.
+
+The owner's push and pop touch only bottom_ in the common case, a CAS on top_ is needed only when owner and thieves
+race for the last element. Thieves CAS top_ forward, a thief that loses the race gets Lost and moves on to another
+victim instead of retrying.
+
+The ring grows by doubling when the owner finds it full. Thieves may still read the previous ring, so replaced rings
+stay alive (chained in previous_) until the deque is destroyed: at most as much memory again as the largest ring.
+
+T is copied in and out of the slots as a whole, it must be trivially copyable (task pointers).
+*/
+namespace erturk::concurrency::lock_free
+{
+
+enum class StealStatus
+{
+    Stolen,
+    Empty,
+    Lost  // another thread took the element first, the deque may still hold more
+};
+
+template <typename T>
+class ChaseLevDeque final
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Deque elements must be trivially copyable!");
+
+    struct Ring
+    {
+        explicit Ring(const size_t capacity, Ring* previous)
+            : capacity_{capacity}, mask_{capacity - 1}, slots_{new std::atomic<T>[capacity]}, previous_{previous}
+        {
+        }
+
+        ~Ring()
+        {
+            delete[] slots_;
+        }
+
+        [[nodiscard]] T load(const int64_t index) const noexcept
+        {
+            return slots_[static_cast<size_t>(index) & mask_].load(std::memory_order_relaxed);
+        }
+
+        void store(const int64_t index, const T value) noexcept
+        {
+            slots_[static_cast<size_t>(index) & mask_].store(value, std::memory_order_relaxed);
+        }
+
+        const size_t capacity_;
+        const size_t mask_;
+        std::atomic<T>* slots_;
+        Ring* previous_;
+    };
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY_ = 256;
+
+    // capacity is rounded up to a power of two
+    explicit ChaseLevDeque(const size_t capacity = DEFAULT_CAPACITY_) noexcept(false)
+        : ring_{new Ring{capacity < 2 ? 2 : std::bit_ceil(capacity), nullptr}}
+    {
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    ~ChaseLevDeque()
+    {
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        while (ring != nullptr)
+        {
+            Ring* previous = ring->previous_;
+            delete ring;
+            ring = previous;
+        }
+    }
+
+    // Owner only
+    void push(const T value) noexcept(false)
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(ring->capacity_) - 1)
+        {
+            ring = grow(ring, top, bottom);
+        }
+
+        ring->store(bottom, value);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only, the most recently pushed element
+    [[nodiscard]] bool pop(T& out) noexcept
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);  // empty
+            return false;
+        }
+
+        out = ring->load(bottom);
+        if (top < bottom)
+        {
+            return true;  // more than one element left, no thief can reach this one
+        }
+
+        // the last element: race the thieves for it
+        const bool won =
+            top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // Any thread, the least recently pushed element
+    [[nodiscard]] StealStatus steal(T& out) noexcept
+    {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return StealStatus::Empty;
+        }
+
+        const T value = ring_.load(std::memory_order_acquire)->load(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return StealStatus::Lost;
+        }
+
+        out = value;
+        return StealStatus::Stolen;
+    }
+
+    // Approximate unless called by the owner with no thief active
+    [[nodiscard]] size_t size() const noexcept
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_relaxed);
+
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+private:
+    [[nodiscard]] Ring* grow(Ring* ring, const int64_t top, const int64_t bottom) noexcept(false)
+    {
+        Ring* grown = new Ring{ring->capacity_ * 2, ring};
+
+        for (int64_t index = top; index < bottom; index++)
+        {
+            grown->store(index, ring->load(index));
+        }
+
+        ring_.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE_) std::atomic<int64_t> top_{0};
+    alignas(CACHE_LINE_SIZE_) std::atomic<int64_t> bottom_{0};
+    std::atomic<Ring*> ring_;
+};
+
+}  // namespace erturk::concurrency::lock_free
+
+#endif  // ERTURK_CHASE_LEV_DEQUE_H
@@ -0,0 +1,505 @@
+#ifndef ERTURK_MPSC_QUEUE_H
+#define ERTURK_MPSC_QUEUE_H
+
+#include "../../allocator/PoolAllocator.hpp"
+#include "Backoff.hpp"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/*
+Unbounded multi-producer single-consumer queue (Vyukov, node based), for mailboxes and log sinks.
+
+Producers append at back_: one exchange of back_, then the link of the previous node. No CAS and no loop, push is
+wait-free and producers never retry against each other. The consumer owns front_ and walks the links, a stub node
+keeps the list non-empty so the last element can be taken without touching back_.
+
+Between the exchange and the link the chain is cut: the consumer stops there and sees the queue as empty until the
+producer finishes (a few instructions), try_pop never waits.
+
+pop_all takes the whole chain with one exchange of back_ (a free stub becomes the new, empty queue) and walks it
+privately, producers keep appending behind the new stub meanwhile. Inside the taken chain it waits for producers
+caught between exchange and link. try_pop may leave its stub linked mid-chain, so there are two stubs: the one that
+may be linked (active_stub_) and a spare that pop_all swaps in. If consume throws, the rest of the taken chain goes
+back in front of the queue.
+
+- IntrusiveMpscQueue<T> : T derives from MpscObject, push and pop move pointers, nothing is allocated.
+- MpscQueue<T, Tag>     : values in nodes recycled through a node pool of Tag. The consumer gives nodes back to a
+                          shared recycle stack (one CAS per pop_all batch), a producer takes the whole stack with one
+                          exchange into its thread cache and allocates from there, fresh nodes come from a mutex
+                          guarded FixedBlockPool in batches. Exchange-all and push only: no ABA on the stack.
+*/
+namespace erturk::concurrency::lock_free
+{
+
+// Hook of an element of IntrusiveMpscQueue
+struct MpscObject
+{
+    std::atomic<MpscObject*> mpsc_next_{nullptr};
+};
+
+template <typename T>
+class IntrusiveMpscQueue final
+{
+public:
+    IntrusiveMpscQueue() noexcept = default;
+
+    IntrusiveMpscQueue(const IntrusiveMpscQueue&) = delete;
+
+    IntrusiveMpscQueue& operator=(const IntrusiveMpscQueue&) = delete;
+
+    // Any thread, wait-free
+    void push(T* element) noexcept
+    {
+        MpscObject* node = static_cast<MpscObject*>(element);
+        node->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+        link(node);
+    }
+
+    // Consumer only, nullptr when empty or the next element is still being linked
+    [[nodiscard]] T* try_pop() noexcept
+    {
+        MpscObject* front = front_;
+        MpscObject* next = front->mpsc_next_.load(std::memory_order_acquire);
+
+        if (front == active_stub_)
+        {
+            if (next == nullptr)
+            {
+                return nullptr;
+            }
+            front_ = next;
+            front = next;
+            next = next->mpsc_next_.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            front_ = next;
+            return static_cast<T*>(front);
+        }
+
+        if (front != back_.load(std::memory_order_acquire))
+        {
+            return nullptr;  // a producer is linking after front
+        }
+
+        // front is the last element: queue the stub behind it to take front out
+        active_stub_->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+        link(active_stub_);
+
+        next = front->mpsc_next_.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            front_ = next;
+            return static_cast<T*>(front);
+        }
+        return nullptr;
+    }
+
+    /**
+     *  @brief  Consumer only, takes every pushed element with one exchange and hands it to consume (T*), in push order
+     *          of each producer. Elements pushed meanwhile stay for the next call.
+     *  @return The number of elements popped.
+     */
+    template <typename Consume>
+    size_t pop_all(Consume&& consume)
+    {
+        MpscObject* first = front_;
+
+        if (first == active_stub_)
+        {
+            first = first->mpsc_next_.load(std::memory_order_acquire);
+            if (first == nullptr)
+            {
+                return 0;  // empty, or the first push is still linking
+            }
+        }
+
+        // first..last is ours, the spare stub is the queue from now on
+        MpscObject* stub = active_stub_ == &stubs_[0] ? &stubs_[1] : &stubs_[0];
+        stub->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+        front_ = stub;
+        active_stub_ = stub;
+        MpscObject* const last = back_.exchange(stub, std::memory_order_acq_rel);
+
+        size_t count = 0;
+        for (MpscObject* node = first; node != nullptr;)
+        {
+            // read before consume, which may reuse the element
+            MpscObject* next = node == last ? nullptr : wait_next(node);
+
+            if (!is_stub(node))
+            {
+                try
+                {
+                    consume(static_cast<T*>(node));
+                }
+                catch (...)
+                {
+                    put_back(next, last);
+                    throw;
+                }
+                count++;
+            }
+            node = next;
+        }
+        return count;
+    }
+
+    // Approximate for producers, exact for the consumer when no push is in progress
+    [[nodiscard]] bool empty() const noexcept
+    {
+        const MpscObject* front = front_;
+        return front->mpsc_next_.load(std::memory_order_acquire) == nullptr &&
+               (front == active_stub_ || front != back_.load(std::memory_order_acquire));
+    }
+
+private:
+    void link(MpscObject* node) noexcept
+    {
+        MpscObject* previous = back_.exchange(node, std::memory_order_acq_rel);
+        previous->mpsc_next_.store(node, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool is_stub(const MpscObject* node) const noexcept
+    {
+        return node == &stubs_[0] || node == &stubs_[1];
+    }
+
+    // node is inside a taken chain, the producer of its successor already swapped back_ and links in a moment
+    [[nodiscard]] static MpscObject* wait_next(const MpscObject* node) noexcept
+    {
+        Backoff backoff{};
+        MpscObject* next = node->mpsc_next_.load(std::memory_order_acquire);
+
+        while (next == nullptr)
+        {
+            backoff.pause();
+            next = node->mpsc_next_.load(std::memory_order_acquire);
+        }
+        return next;
+    }
+
+    // Relinks node..last (without the old stub) in front of the queue, only active_stub_ may stay linked
+    void put_back(MpscObject* node, MpscObject* const last) noexcept
+    {
+        MpscObject* head = nullptr;
+        MpscObject* tail = nullptr;
+
+        while (node != nullptr)
+        {
+            MpscObject* next = node == last ? nullptr : wait_next(node);
+
+            if (!is_stub(node))
+            {
+                if (tail == nullptr)
+                {
+                    head = node;
+                }
+                else
+                {
+                    tail->mpsc_next_.store(node, std::memory_order_relaxed);
+                }
+                tail = node;
+            }
+            node = next;
+        }
+
+        if (head != nullptr)
+        {
+            tail->mpsc_next_.store(front_, std::memory_order_relaxed);
+            front_ = head;
+        }
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE_) std::atomic<MpscObject*> back_{&stubs_[0]};
+    alignas(CACHE_LINE_SIZE_) MpscObject* front_{&stubs_[0]};
+    MpscObject* active_stub_{&stubs_[0]};
+    MpscObject stubs_[2]{};
+};
+
+namespace mpsc
+{
+
+inline constexpr size_t REFILL_BATCH_ = 32;  // fresh nodes taken from the block pool per lock
+
+struct FreeNode
+{
+    FreeNode* next_;
+};
+
+// Nodes of one size shared by every queue of Tag, free nodes move between threads through recycled_
+template <size_t BLOCK_SIZE, size_t ALIGNMENT>
+class SharedNodePool final
+{
+public:
+    // Pops the recycle stack as a whole, falls back to a batch of fresh blocks
+    [[nodiscard]] FreeNode* take_chain() noexcept
+    {
+        FreeNode* chain = recycled_.exchange(nullptr, std::memory_order_acquire);
+
+        if (chain != nullptr)
+        {
+            return chain;
+        }
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (size_t idx = 0; idx < REFILL_BATCH_; idx++)
+        {
+            FreeNode* node = static_cast<FreeNode*>(pool_.allocate());
+            if (node == nullptr)
+            {
+                break;
+            }
+            node->next_ = chain;
+            chain = node;
+        }
+        return chain;
+    }
+
+    // Pushes first..last (linked through next_) onto the recycle stack
+    void recycle_chain(FreeNode* first, FreeNode* last) noexcept
+    {
+        FreeNode* top = recycled_.load(std::memory_order_relaxed);
+
+        do
+        {
+            last->next_ = top;
+        } while (!recycled_.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+private:
+    std::atomic<FreeNode*> recycled_{nullptr};
+    std::mutex mutex_;
+    erturk::allocator::FixedBlockPool<BLOCK_SIZE, ALIGNMENT> pool_{};
+};
+
+// Never destroyed, nodes may be recycled after static destruction started
+template <size_t BLOCK_SIZE, size_t ALIGNMENT, class Tag>
+[[nodiscard]] inline SharedNodePool<BLOCK_SIZE, ALIGNMENT>& shared_node_pool() noexcept
+{
+    static SharedNodePool<BLOCK_SIZE, ALIGNMENT>* pool = new SharedNodePool<BLOCK_SIZE, ALIGNMENT>{};
+    return *pool;
+}
+
+template <size_t BLOCK_SIZE, size_t ALIGNMENT, class Tag>
+inline thread_local bool node_cache_released_ = false;
+
+// Free nodes of the calling thread, back to the shared pool at thread exit
+template <size_t BLOCK_SIZE, size_t ALIGNMENT, class Tag>
+struct NodeCache
+{
+    ~NodeCache()
+    {
+        if (free_ != nullptr)
+        {
+            FreeNode* last = free_;
+            while (last->next_ != nullptr)
+            {
+                last = last->next_;
+            }
+            shared_node_pool<BLOCK_SIZE, ALIGNMENT, Tag>().recycle_chain(free_, last);
+        }
+        node_cache_released_<BLOCK_SIZE, ALIGNMENT, Tag> = true;
+    }
+
+    FreeNode* free_{nullptr};
+};
+
+template <size_t BLOCK_SIZE, size_t ALIGNMENT, class Tag>
+[[nodiscard]] inline void* allocate_node() noexcept
+{
+    SharedNodePool<BLOCK_SIZE, ALIGNMENT>& shared = shared_node_pool<BLOCK_SIZE, ALIGNMENT, Tag>();
+
+    if (node_cache_released_<BLOCK_SIZE, ALIGNMENT, Tag>)
+    {
+        // thread exit: take one node, give the rest back
+        FreeNode* chain = shared.take_chain();
+        if (chain != nullptr && chain->next_ != nullptr)
+        {
+            FreeNode* last = chain->next_;
+            while (last->next_ != nullptr)
+            {
+                last = last->next_;
+            }
+            shared.recycle_chain(chain->next_, last);
+        }
+        return chain;
+    }
+
+    thread_local NodeCache<BLOCK_SIZE, ALIGNMENT, Tag> cache{};
+
+    if (cache.free_ == nullptr)
+    {
+        cache.free_ = shared.take_chain();
+        if (cache.free_ == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    FreeNode* node = cache.free_;
+    cache.free_ = node->next_;
+    return node;
+}
+
+}  // namespace mpsc
+
+template <typename T, class Tag = erturk::allocator::DefaultPoolTag>
+class MpscQueue final
+{
+    struct Node : MpscObject
+    {
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : value_{std::forward<Args>(args)...}
+        {
+        }
+
+        T value_;
+    };
+
+    static constexpr size_t NODE_SIZE_ = sizeof(Node) > sizeof(mpsc::FreeNode) ? sizeof(Node) : sizeof(mpsc::FreeNode);
+    static constexpr size_t NODE_ALIGNMENT_ =
+        alignof(Node) > alignof(mpsc::FreeNode) ? alignof(Node) : alignof(mpsc::FreeNode);
+
+public:
+    MpscQueue() noexcept = default;
+
+    MpscQueue(const MpscQueue&) = delete;
+
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue()
+    {
+        pop_all([](T&&) {});
+    }
+
+    // Any thread, wait-free once the thread's node cache is filled
+    template <typename... Args>
+    void emplace(Args&&... args) noexcept(false)
+    {
+        void* block = mpsc::allocate_node<NODE_SIZE_, NODE_ALIGNMENT_, Tag>();
+
+        if (block == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+
+        Node* node = nullptr;
+        try
+        {
+            node = new (block) Node{std::in_place, std::forward<Args>(args)...};
+        }
+        catch (...)
+        {
+            mpsc::FreeNode* free_node = static_cast<mpsc::FreeNode*>(block);
+            mpsc::shared_node_pool<NODE_SIZE_, NODE_ALIGNMENT_, Tag>().recycle_chain(free_node, free_node);
+            throw;
+        }
+        queue_.push(node);
+    }
+
+    void push(const T& value)
+    {
+        emplace(value);
+    }
+
+    void push(T&& value)
+    {
+        emplace(std::move(value));
+    }
+
+    // Consumer only
+    [[nodiscard]] bool try_pop(T& out)
+    {
+        Node* node = queue_.try_pop();
+
+        if (node == nullptr)
+        {
+            return false;
+        }
+
+        out = std::move(node->value_);
+        mpsc::FreeNode* free_node = release(node);
+        mpsc::shared_node_pool<NODE_SIZE_, NODE_ALIGNMENT_, Tag>().recycle_chain(free_node, free_node);
+        return true;
+    }
+
+    /**
+     *  @brief  Consumer only, drains the queue into consume (T&&), the nodes go back to the pool with one CAS.
+     *          If consume throws, its value is dropped, the values behind it stay queued and the exception propagates.
+     *  @return The number of values popped.
+     */
+    template <typename Consume>
+    size_t pop_all(Consume&& consume)
+    {
+        mpsc::FreeNode* first = nullptr;
+        mpsc::FreeNode* last = nullptr;
+
+        const auto retire = [&first, &last](Node* node) noexcept
+        {
+            mpsc::FreeNode* free_node = release(node);
+            free_node->next_ = first;
+            first = free_node;
+            last = last == nullptr ? free_node : last;
+        };
+
+        size_t count = 0;
+        try
+        {
+            count = queue_.pop_all(
+                [&consume, &retire](Node* node)
+                {
+                    try
+                    {
+                        consume(std::move(node->value_));
+                    }
+                    catch (...)
+                    {
+                        retire(node);
+                        throw;
+                    }
+                    retire(node);
+                });
+        }
+        catch (...)
+        {
+            recycle(first, last);
+            throw;
+        }
+
+        recycle(first, last);
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return queue_.empty();
+    }
+
+private:
+    static void recycle(mpsc::FreeNode* first, mpsc::FreeNode* last) noexcept
+    {
+        if (first != nullptr)
+        {
+            mpsc::shared_node_pool<NODE_SIZE_, NODE_ALIGNMENT_, Tag>().recycle_chain(first, last);
+        }
+    }
+
+    [[nodiscard]] static mpsc::FreeNode* release(Node* node) noexcept
+    {
+        node->~Node();
+        return new (static_cast<void*>(node)) mpsc::FreeNode{nullptr};
+    }
+
+private:
+    IntrusiveMpscQueue<Node> queue_{};
+};
+
+}  // namespace erturk::concurrency::lock_free
+
+#endif  // ERTURK_MPSC_QUEUE_H
@@ -0,0 +1,191 @@
+#ifndef ERTURK_SPSC_RING_H
+#define ERTURK_SPSC_RING_H
+
+#include "Backoff.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+Wait-free single-producer single-consumer ring, for hand-offs between two pinned pipeline stages.
+
+The producer owns write_pos_, the consumer owns read_pos_, both only grow and are masked into the power of two
+ring. Each side keeps a plain copy of the other side's position on its own cache line and reloads the shared one
+only when the copy says full / empty: in steady state a hop touches no cache line written by the other thread except
+the slot itself, positions do not bounce between the cores.
+
+Slots hold constructed T (default constructed at start), values are assigned in and moved out. This lets the span
+API hand out live objects:
+
+- write_span(n) / commit_write(n) : the producer fills up to n contiguous free slots in place, then publishes them.
+- read_span(n) / commit_read(n)   : the consumer reads up to n contiguous values in place, then frees the slots.
+
+Spans end at the ring's wrap point, a second call returns the part after it. One release store per commit, a batch
+costs the same synchronization as a single value.
+*/
+namespace erturk::concurrency::lock_free
+{
+
+template <typename T>
+class SpscRing final
+{
+    static_assert(std::is_default_constructible_v<T>, "Slots are default constructed!");
+
+public:
+    // capacity is rounded up to a power of two (at least 2)
+    explicit SpscRing(const size_t capacity) noexcept(false)
+        : capacity_{ring_capacity(capacity)}, mask_{capacity_ - 1}
+    {
+        slots_ = new T[capacity_]{};
+    }
+
+    SpscRing(const SpscRing&) = delete;
+
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    ~SpscRing()
+    {
+        delete[] slots_;
+    }
+
+    // Producer only
+    template <typename U>
+    [[nodiscard]] bool try_push(U&& value)
+    {
+        const size_t write_pos = write_pos_.load(std::memory_order_relaxed);
+
+        if (free_slots(write_pos, 1) == 0)
+        {
+            return false;
+        }
+
+        slots_[write_pos & mask_] = std::forward<U>(value);
+        write_pos_.store(write_pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    [[nodiscard]] bool try_pop(T& out)
+    {
+        const size_t read_pos = read_pos_.load(std::memory_order_relaxed);
+
+        if (ready_slots(read_pos, 1) == 0)
+        {
+            return false;
+        }
+
+        out = std::move(slots_[read_pos & mask_]);
+        read_pos_.store(read_pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only, contiguous free slots (at most max_count), empty when the ring is full
+    [[nodiscard]] std::span<T> write_span(const size_t max_count) noexcept
+    {
+        const size_t write_pos = write_pos_.load(std::memory_order_relaxed);
+        const size_t index = write_pos & mask_;
+
+        const size_t wanted = std::min(capacity_ - index, max_count);
+        const size_t count = std::min(free_slots(write_pos, wanted), wanted);
+        return std::span<T>{slots_ + index, count};
+    }
+
+    // Producer only, publishes the first count slots of the last write_span
+    void commit_write(const size_t count) noexcept
+    {
+        write_pos_.store(write_pos_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer only, contiguous values (at most max_count), empty when the ring is empty
+    [[nodiscard]] std::span<T> read_span(const size_t max_count) noexcept
+    {
+        const size_t read_pos = read_pos_.load(std::memory_order_relaxed);
+        const size_t index = read_pos & mask_;
+
+        const size_t wanted = std::min(capacity_ - index, max_count);
+        const size_t count = std::min(ready_slots(read_pos, wanted), wanted);
+        return std::span<T>{slots_ + index, count};
+    }
+
+    // Consumer only, frees the first count slots of the last read_span
+    void commit_read(const size_t count) noexcept
+    {
+        read_pos_.store(read_pos_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // Approximate while the other side works
+    [[nodiscard]] size_t size() const noexcept
+    {
+        const size_t read_pos = read_pos_.load(std::memory_order_acquire);
+        const size_t write_pos = write_pos_.load(std::memory_order_acquire);
+
+        return write_pos > read_pos ? write_pos - read_pos : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+private:
+    // Validated before bit_ceil, which is undefined past the largest power of two
+    [[nodiscard]] static size_t ring_capacity(const size_t capacity) noexcept(false)
+    {
+        if (capacity > (size_t{1} << (sizeof(size_t) * 8 - 2)))
+        {
+            throw std::runtime_error("Ring capacity is too large!");
+        }
+        return capacity < 2 ? 2 : std::bit_ceil(capacity);
+    }
+
+    // Producer side, reloads read_pos_ only when the cached copy shows less room than wanted
+    [[nodiscard]] size_t free_slots(const size_t write_pos, const size_t wanted) noexcept
+    {
+        size_t free = capacity_ - (write_pos - cached_read_pos_);
+
+        if (free < wanted)
+        {
+            cached_read_pos_ = read_pos_.load(std::memory_order_acquire);
+            free = capacity_ - (write_pos - cached_read_pos_);
+        }
+        return free;
+    }
+
+    // Consumer side, reloads write_pos_ only when the cached copy shows fewer values than wanted
+    [[nodiscard]] size_t ready_slots(const size_t read_pos, const size_t wanted) noexcept
+    {
+        size_t ready = cached_write_pos_ - read_pos;
+
+        if (ready < wanted)
+        {
+            cached_write_pos_ = write_pos_.load(std::memory_order_acquire);
+            ready = cached_write_pos_ - read_pos;
+        }
+        return ready;
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE_) std::atomic<size_t> write_pos_{0};
+    size_t cached_read_pos_{0};  // producer's copy of read_pos_
+
+    alignas(CACHE_LINE_SIZE_) std::atomic<size_t> read_pos_{0};
+    size_t cached_write_pos_{0};  // consumer's copy of write_pos_
+
+    alignas(CACHE_LINE_SIZE_) const size_t capacity_;
+    const size_t mask_;
+    T* slots_;
+};
+
+}  // namespace erturk::concurrency::lock_free
+
+#endif  // ERTURK_SPSC_RING_H
@@ -0,0 +1,472 @@
+#ifndef ERTURK_EPOCH_RECLAMATION_H
+#define ERTURK_EPOCH_RECLAMATION_H
+
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+Epoch-based reclamation (Fraser, 2004), the low overhead alternative to HazardPointers.hpp for read-mostly structures.
+
+A reader announces the global epoch when it enters a critical section and may dereference any node reachable in it,
+however many, until it exits. A retired node is tagged with the epoch it was retired in and freed once the global
+epoch is two ahead: every reader that could still see it has exited since.
+
+- enter/exit : one store of the thread's epoch word each, nested sections only count. The store-load ordering
+               between announcing and reading is paid by the advancing thread: it issues membarrier (private
+               expedited), which orders the announcement of every running thread, readers need a compiler fence only.
+               Without membarrier (old kernels) readers fall back to a seq_cst fence.
+- retire     : a fence and a push onto the thread's limbo list of the current epoch, one of three buckets.
+- advancing  : amortized, a thread whose limbo lists reach the retire threshold tries to advance the global epoch (every
+               active reader has announced the current one) and frees its buckets two epochs old. advance_epoch can be
+               called from a maintenance thread as well.
+- A thread that exits hands its buckets to the domain, they are freed by a later advance.
+
+A reader stalled inside a critical section blocks reclamation (memory grows, nothing is unsafe), keep sections short.
+
+  struct Route : erturk::concurrency::reclamation::EpochObject { ... };
+
+  reader:  EpochGuard<> guard{};
+           const Route* route = table_.load(std::memory_order_acquire);  // valid until guard is destroyed
+  writer:  Route* old = table_.exchange(new_route);
+           retire_epoch(old);
+*/
+namespace erturk::concurrency::reclamation
+{
+
+inline constexpr size_t EPOCH_BUCKETS_ = 3;
+inline constexpr size_t DEFAULT_EPOCH_RETIRE_THRESHOLD_ = 128;
+
+struct DefaultEpochTag
+{
+};
+
+// Intrusive hook of a retired node
+struct EpochObject
+{
+    EpochObject* retired_next_{nullptr};
+    void (*reclaim_)(EpochObject*){nullptr};
+};
+
+namespace epoch
+{
+
+inline constexpr uint64_t ACTIVE_ = 1;  // low bit of a thread's epoch word, epochs count in steps of 2
+inline constexpr uint64_t EPOCH_STEP_ = 2;
+
+template <typename T, typename Deleter>
+struct RetiredBox final : EpochObject
+{
+    RetiredBox(T* ptr, Deleter&& deleter) : ptr_{ptr}, deleter_{std::move(deleter)} {}
+
+    T* ptr_;
+    Deleter deleter_;
+};
+
+struct LimboBucket
+{
+    EpochObject* first_{nullptr};
+    uint64_t epoch_{0};
+};
+
+struct alignas(64) EpochRecord
+{
+    std::atomic<uint64_t> announced_{0};  // epoch | ACTIVE_ while in a critical section
+    std::atomic<bool> in_use_{false};
+    EpochRecord* next_{nullptr};  // immutable once the record is published
+
+    // owner thread only
+    uint32_t nesting_{0};
+    size_t retired_count_{0};
+    size_t collect_at_{0};  // retired count of the next collect, the threshold above what a collect could not free
+    LimboBucket limbo_[EPOCH_BUCKETS_]{};
+};
+
+// Retired nodes of an exited thread
+struct OrphanBatch
+{
+    EpochObject* first_;
+    uint64_t epoch_;
+    OrphanBatch* next_;
+};
+
+inline void reclaim_list(EpochObject* object) noexcept
+{
+    while (object != nullptr)
+    {
+        EpochObject* next = object->retired_next_;
+        object->reclaim_(object);
+        object = next;
+    }
+}
+
+[[nodiscard]] inline bool register_membarrier() noexcept
+{
+    return ::syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+}
+
+// Registered once per process, shared by every domain
+[[nodiscard]] inline bool asymmetric_fences() noexcept
+{
+    static const bool registered = register_membarrier();
+    return registered;
+}
+
+class EpochDomain
+{
+public:
+    EpochDomain() noexcept : asymmetric_{asymmetric_fences()} {}
+
+    [[nodiscard]] EpochRecord* acquire_record()
+    {
+        for (EpochRecord* record = head_.load(std::memory_order_acquire); record != nullptr; record = record->next_)
+        {
+            bool expected = false;
+            if (!record->in_use_.load(std::memory_order_relaxed) &&
+                record->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return record;
+            }
+        }
+
+        EpochRecord* record = new EpochRecord{};
+        record->in_use_.store(true, std::memory_order_relaxed);
+
+        EpochRecord* head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            record->next_ = head;
+        } while (!head_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+        return record;
+    }
+
+    void release_record(EpochRecord* record)
+    {
+        for (LimboBucket& bucket : record->limbo_)
+        {
+            if (bucket.first_ != nullptr)
+            {
+                hand_over(bucket.first_, bucket.epoch_);
+                bucket.first_ = nullptr;
+            }
+        }
+        record->retired_count_ = 0;
+        record->collect_at_ = 0;
+        record->nesting_ = 0;
+        record->announced_.store(0, std::memory_order_release);
+        record->in_use_.store(false, std::memory_order_release);
+    }
+
+    void enter(EpochRecord* record) noexcept
+    {
+        if (record->nesting_++ != 0)
+        {
+            return;
+        }
+
+        record->announced_.store(global_epoch_.load(std::memory_order_acquire) | ACTIVE_, std::memory_order_relaxed);
+
+        if (asymmetric_)
+        {
+            std::atomic_signal_fence(std::memory_order_seq_cst);  // the advancer's membarrier orders it
+        }
+        else
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void exit(EpochRecord* record) noexcept
+    {
+        if (--record->nesting_ == 0)
+        {
+            // every read of the section happens before the next advance sees the thread inactive
+            record->announced_.store(0, std::memory_order_release);
+        }
+    }
+
+    void retire(EpochRecord* record, EpochObject* object)
+    {
+        // the unlink of object is visible before the epoch it is tagged with is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+        LimboBucket& bucket = record->limbo_[(epoch / EPOCH_STEP_) % EPOCH_BUCKETS_];
+
+        // the bucket was last filled three epochs ago or earlier, nobody can reach its nodes
+        if (bucket.epoch_ != epoch)
+        {
+            EpochObject* expired = bucket.first_;
+            bucket.first_ = nullptr;
+            bucket.epoch_ = epoch;
+            reclaim_list(expired);  // the destructors may retire again, the bucket is reset first
+        }
+
+        object->retired_next_ = bucket.first_;
+        bucket.first_ = object;
+
+        if (++record->retired_count_ >= record->collect_at_)
+        {
+            try_advance();
+            collect(record);
+        }
+    }
+
+    // Advances the global epoch when every active thread has announced the current one
+    bool try_advance() noexcept
+    {
+        const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+
+        if (asymmetric_)
+        {
+            ::syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        }
+        else
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        for (EpochRecord* record = head_.load(std::memory_order_acquire); record != nullptr; record = record->next_)
+        {
+            const uint64_t announced = record->announced_.load(std::memory_order_acquire);
+
+            if ((announced & ACTIVE_) != 0 && (announced & ~ACTIVE_) != epoch)
+            {
+                return false;
+            }
+        }
+
+        uint64_t expected = epoch;
+        const bool advanced = global_epoch_.compare_exchange_strong(expected, epoch + EPOCH_STEP_,
+                                                                    std::memory_order_acq_rel);
+        reclaim_orphans();
+        return advanced;
+    }
+
+    // Frees the buckets of record that are two epochs behind
+    void collect(EpochRecord* record) noexcept
+    {
+        const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+        size_t remaining = 0;
+
+        for (LimboBucket& bucket : record->limbo_)
+        {
+            if (bucket.first_ == nullptr)
+            {
+                continue;
+            }
+
+            if (bucket.epoch_ + 2 * EPOCH_STEP_ <= epoch)
+            {
+                EpochObject* first = bucket.first_;
+                bucket.first_ = nullptr;
+                reclaim_list(first);  // the destructors may retire again, the bucket is detached first
+            }
+            else
+            {
+                for (EpochObject* object = bucket.first_; object != nullptr; object = object->retired_next_)
+                {
+                    remaining++;
+                }
+            }
+        }
+        record->retired_count_ = remaining;
+        record->collect_at_ = remaining + retire_threshold_.load(std::memory_order_relaxed);
+    }
+
+    void set_retire_threshold(const size_t threshold) noexcept
+    {
+        retire_threshold_.store(threshold, std::memory_order_relaxed);
+    }
+
+private:
+    void hand_over(EpochObject* first, const uint64_t epoch)
+    {
+        OrphanBatch* batch = new OrphanBatch{first, epoch, orphans_.load(std::memory_order_relaxed)};
+
+        while (!orphans_.compare_exchange_weak(batch->next_, batch, std::memory_order_release,
+                                               std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void reclaim_orphans() noexcept
+    {
+        if (orphans_.load(std::memory_order_relaxed) == nullptr)
+        {
+            return;
+        }
+
+        const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+        OrphanBatch* batch = orphans_.exchange(nullptr, std::memory_order_acquire);
+
+        while (batch != nullptr)
+        {
+            OrphanBatch* next = batch->next_;
+
+            if (batch->epoch_ + 2 * EPOCH_STEP_ <= epoch)
+            {
+                reclaim_list(batch->first_);
+                delete batch;
+            }
+            else
+            {
+                batch->next_ = orphans_.load(std::memory_order_relaxed);
+                while (!orphans_.compare_exchange_weak(batch->next_, batch, std::memory_order_release,
+                                                       std::memory_order_relaxed))
+                {
+                }
+            }
+            batch = next;
+        }
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> global_epoch_{EPOCH_STEP_};
+    alignas(64) std::atomic<EpochRecord*> head_{nullptr};
+    std::atomic<OrphanBatch*> orphans_{nullptr};
+    std::atomic<size_t> retire_threshold_{DEFAULT_EPOCH_RETIRE_THRESHOLD_};
+    const bool asymmetric_;
+};
+
+// Never destroyed, threads may exit after static destruction started
+template <class Tag>
+[[nodiscard]] inline EpochDomain& epoch_domain() noexcept
+{
+    static EpochDomain* domain = new EpochDomain{};
+    return *domain;
+}
+
+template <class Tag>
+inline thread_local EpochRecord* local_record_ = nullptr;
+
+template <class Tag>
+inline thread_local bool record_released_ = false;
+
+template <class Tag>
+struct RecordGuard
+{
+    ~RecordGuard()
+    {
+        if (local_record_<Tag> != nullptr)
+        {
+            epoch_domain<Tag>().release_record(local_record_<Tag>);
+            local_record_<Tag> = nullptr;
+        }
+        record_released_<Tag> = true;
+    }
+};
+
+template <class Tag>
+[[nodiscard]] inline EpochRecord* local_record()
+{
+    EpochRecord* record = local_record_<Tag>;
+
+    if (record == nullptr) [[unlikely]]
+    {
+        thread_local RecordGuard<Tag> guard{};
+        (void)guard;
+
+        record = epoch_domain<Tag>().acquire_record();
+        local_record_<Tag> = record;
+    }
+    return record;
+}
+
+template <class Tag>
+inline void retire_object(EpochObject* object)
+{
+    EpochDomain& domain = epoch_domain<Tag>();
+
+    if (!record_released_<Tag>)
+    {
+        domain.retire(local_record<Tag>(), object);
+    }
+    else
+    {
+        // thread_local destructors after the record's, the node goes straight to the domain
+        EpochRecord* record = domain.acquire_record();
+        domain.retire(record, object);
+        domain.release_record(record);
+    }
+}
+
+}  // namespace epoch
+
+// Critical section of the calling thread, nodes read inside stay valid until destruction
+template <class Tag = DefaultEpochTag>
+class EpochGuard
+{
+public:
+    EpochGuard() : record_{epoch::local_record<Tag>()}
+    {
+        epoch::epoch_domain<Tag>().enter(record_);
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+    ~EpochGuard()
+    {
+        epoch::epoch_domain<Tag>().exit(record_);
+    }
+
+private:
+    epoch::EpochRecord* record_;
+};
+
+// Reclaimed with delete two epochs later
+template <class Tag = DefaultEpochTag, typename T>
+void retire_epoch(T* object)
+{
+    static_assert(std::is_base_of_v<EpochObject, T>, "T must derive from EpochObject, or pass a deleter!");
+
+    object->reclaim_ = [](EpochObject* retired) { delete static_cast<T*>(retired); };
+
+    epoch::retire_object<Tag>(object);
+}
+
+// Reclaimed with deleter(ptr) two epochs later
+template <class Tag = DefaultEpochTag, typename T, typename Deleter>
+void retire_epoch(T* ptr, Deleter deleter)
+{
+    using Box = epoch::RetiredBox<T, Deleter>;
+
+    Box* box = new Box{ptr, std::move(deleter)};
+    box->reclaim_ = [](EpochObject* retired) {
+        Box* retired_box = static_cast<Box*>(retired);
+        retired_box->deleter_(retired_box->ptr_);
+        delete retired_box;
+    };
+
+    epoch::retire_object<Tag>(box);
+}
+
+// Tries to advance the epoch and frees what the calling thread can, for maintenance threads or quiescent points
+template <class Tag = DefaultEpochTag>
+bool advance_epoch()
+{
+    epoch::EpochDomain& domain = epoch::epoch_domain<Tag>();
+
+    const bool advanced = domain.try_advance();
+    domain.collect(epoch::local_record<Tag>());
+    return advanced;
+}
+
+template <class Tag = DefaultEpochTag>
+void set_epoch_retire_threshold(const size_t threshold) noexcept
+{
+    epoch::epoch_domain<Tag>().set_retire_threshold(threshold);
+}
+
+}  // namespace erturk::concurrency::reclamation
+
+#endif  // ERTURK_EPOCH_RECLAMATION_H
@@ -1,4 +1,423 @@
 #ifndef ERTURK_HAZARD_POINTERS_H
 #define ERTURK_HAZARD_POINTERS_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Hazard pointers (Michael, 2004): a reader publishes the address it is about to dereference in a hazard slot, a writer
+that unlinked a node retires it and the node is reclaimed only once no slot holds its address.
+
+- HazardRecord : one per thread and domain, HAZARD_SLOTS_ slots on their own cache line. Records are never freed, a
+                 record of an exited thread is reused by the next new thread.
+- HazardPointer: RAII owner of one slot of the calling thread, protect(source) publishes and validates the pointer.
+- retire       : pushes onto the calling thread's retired list, no atomics. Once the list reaches the threshold
+                 (max(retire threshold, 2 * slots of all records)) a scan reads every slot once, sorts them and frees
+                 every retired node not found, at least half of the list by the threshold choice: the scan cost is
+                 spread over as many retires as it frees, O(log H) per retire.
+- Retired nodes of an exiting thread are handed to the domain and adopted by the next scan of any thread.
+
+Nodes derive from HazardObject for an allocation-free retire (delete on reclaim), any other pointer is retired with a
+deleter in a small box:
+
+  struct Node : erturk::concurrency::reclamation::HazardObject { int value_; std::atomic<Node*> next_; };
+  std::atomic<Node*> head_;
+
+  reader:  HazardPointer<> hazard{};
+           Node* node = hazard.protect(head_);  // safe to dereference until reset or destruction of hazard
+  writer:  Node* old = head_.exchange(new_node);
+           retire(old);
+
+Each Tag is an independent domain, a data structure with many retires can keep its scans away from the others.
+*/
+namespace erturk::concurrency::reclamation
+{
+
+inline constexpr size_t HAZARD_SLOTS_ = 8;  // per thread and domain
+inline constexpr size_t DEFAULT_RETIRE_THRESHOLD_ = 64;
+
+struct DefaultHazardTag
+{
+};
+
+// Intrusive hook of a retired node
+struct HazardObject
+{
+    const void* retired_address_{nullptr};  // address readers protect
+    HazardObject* retired_next_{nullptr};
+    void (*reclaim_)(HazardObject*){nullptr};
+};
+
+namespace hazard
+{
+
+template <typename T, typename Deleter>
+struct RetiredBox final : HazardObject
+{
+    RetiredBox(T* ptr, Deleter&& deleter) : ptr_{ptr}, deleter_{std::move(deleter)} {}
+
+    T* ptr_;
+    Deleter deleter_;
+};
+
+struct alignas(64) HazardRecord
+{
+    std::atomic<const void*> slots_[HAZARD_SLOTS_]{};
+    std::atomic<bool> in_use_{false};
+    HazardRecord* next_{nullptr};  // immutable once the record is published
+
+    // owner thread only
+    uint32_t free_slots_{(uint32_t{1} << HAZARD_SLOTS_) - 1};
+    HazardObject* retired_{nullptr};
+    size_t retired_count_{0};
+};
+
+class HazardDomain
+{
+public:
+    [[nodiscard]] HazardRecord* acquire_record()
+    {
+        for (HazardRecord* record = head_.load(std::memory_order_acquire); record != nullptr; record = record->next_)
+        {
+            bool expected = false;
+            if (!record->in_use_.load(std::memory_order_relaxed) &&
+                record->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return record;
+            }
+        }
+
+        HazardRecord* record = new HazardRecord{};
+        record->in_use_.store(true, std::memory_order_relaxed);
+
+        HazardRecord* head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            record->next_ = head;
+        } while (!head_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+        record_count_.fetch_add(1, std::memory_order_relaxed);
+        return record;
+    }
+
+    // Slots are cleared, the retired nodes go to the domain for adoption
+    void release_record(HazardRecord* record) noexcept
+    {
+        for (std::atomic<const void*>& slot : record->slots_)
+        {
+            slot.store(nullptr, std::memory_order_release);
+        }
+        record->free_slots_ = (uint32_t{1} << HAZARD_SLOTS_) - 1;
+
+        if (record->retired_ != nullptr)
+        {
+            hand_over(record->retired_);
+            record->retired_ = nullptr;
+            record->retired_count_ = 0;
+        }
+
+        record->in_use_.store(false, std::memory_order_release);
+    }
+
+    void retire(HazardRecord* record, HazardObject* object)
+    {
+        object->retired_next_ = record->retired_;
+        record->retired_ = object;
+
+        if (++record->retired_count_ >= retire_threshold())
+        {
+            scan(record);
+        }
+    }
+
+    // Frees every retired node of record (and the adopted ones) that no slot protects
+    void scan(HazardRecord* record)
+    {
+        adopt(record);
+
+        // pairs with the fence of HazardPointer::protect: either the reader sees the node unlinked or the scan sees
+        // its slot
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::vector<const void*> hazards{};
+        hazards.reserve(record_count_.load(std::memory_order_relaxed) * HAZARD_SLOTS_);
+
+        for (HazardRecord* other = head_.load(std::memory_order_acquire); other != nullptr; other = other->next_)
+        {
+            for (const std::atomic<const void*>& slot : other->slots_)
+            {
+                const void* hazard = slot.load(std::memory_order_acquire);
+                if (hazard != nullptr)
+                {
+                    hazards.push_back(hazard);
+                }
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        HazardObject* kept = nullptr;
+        HazardObject* kept_last = nullptr;
+        size_t kept_count = 0;
+
+        // detached first, a reclaimed node's destructor may retire more nodes
+        HazardObject* object = record->retired_;
+        record->retired_ = nullptr;
+        record->retired_count_ = 0;
+
+        while (object != nullptr)
+        {
+            HazardObject* next = object->retired_next_;
+
+            if (std::binary_search(hazards.begin(), hazards.end(), object->retired_address_))
+            {
+                object->retired_next_ = kept;
+                kept = object;
+                kept_last = kept_last == nullptr ? object : kept_last;
+                kept_count++;
+            }
+            else
+            {
+                object->reclaim_(object);
+            }
+            object = next;
+        }
+
+        if (kept != nullptr)
+        {
+            kept_last->retired_next_ = record->retired_;
+            record->retired_ = kept;
+            record->retired_count_ += kept_count;
+        }
+    }
+
+    void set_retire_threshold(const size_t threshold) noexcept
+    {
+        retire_threshold_.store(threshold, std::memory_order_relaxed);
+    }
+
+    // At least twice the slot count, a scan frees at least half of what it looks at
+    [[nodiscard]] size_t retire_threshold() const noexcept
+    {
+        const size_t configured = retire_threshold_.load(std::memory_order_relaxed);
+        const size_t slot_bound = 2 * HAZARD_SLOTS_ * record_count_.load(std::memory_order_relaxed);
+
+        return configured > slot_bound ? configured : slot_bound;
+    }
+
+private:
+    void hand_over(HazardObject* first) noexcept
+    {
+        HazardObject* last = first;
+        while (last->retired_next_ != nullptr)
+        {
+            last = last->retired_next_;
+        }
+
+        HazardObject* head = orphans_.load(std::memory_order_relaxed);
+        do
+        {
+            last->retired_next_ = head;
+        } while (!orphans_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void adopt(HazardRecord* record) noexcept
+    {
+        if (orphans_.load(std::memory_order_relaxed) == nullptr)
+        {
+            return;
+        }
+
+        HazardObject* object = orphans_.exchange(nullptr, std::memory_order_acquire);
+        while (object != nullptr)
+        {
+            HazardObject* next = object->retired_next_;
+            object->retired_next_ = record->retired_;
+            record->retired_ = object;
+            record->retired_count_++;
+            object = next;
+        }
+    }
+
+private:
+    std::atomic<HazardRecord*> head_{nullptr};
+    std::atomic<size_t> record_count_{0};
+    std::atomic<HazardObject*> orphans_{nullptr};
+    std::atomic<size_t> retire_threshold_{DEFAULT_RETIRE_THRESHOLD_};
+};
+
+// Never destroyed, threads may exit after static destruction started
+template <class Tag>
+[[nodiscard]] inline HazardDomain& hazard_domain() noexcept
+{
+    static HazardDomain* domain = new HazardDomain{};
+    return *domain;
+}
+
+template <class Tag>
+inline thread_local bool record_released_ = false;
+
+template <class Tag>
+struct RecordGuard
+{
+    RecordGuard() : record_{hazard_domain<Tag>().acquire_record()} {}
+
+    ~RecordGuard()
+    {
+        hazard_domain<Tag>().release_record(record_);
+        record_released_<Tag> = true;
+    }
+
+    HazardRecord* record_;
+};
+
+template <class Tag>
+[[nodiscard]] inline HazardRecord* local_record()
+{
+    thread_local RecordGuard<Tag> guard{};
+    return guard.record_;
+}
+
+template <class Tag>
+inline void retire_object(HazardObject* object)
+{
+    HazardDomain& domain = hazard_domain<Tag>();
+
+    if (!record_released_<Tag>)
+    {
+        domain.retire(local_record<Tag>(), object);
+    }
+    else
+    {
+        // thread_local destructors after the record's, the node goes straight to the domain
+        HazardRecord* record = domain.acquire_record();
+        domain.retire(record, object);
+        domain.release_record(record);
+    }
+}
+
+}  // namespace hazard
+
+template <class Tag = DefaultHazardTag>
+class HazardPointer
+{
+public:
+    // Takes a free slot of the calling thread
+    HazardPointer() noexcept(false) : record_{hazard::local_record<Tag>()}
+    {
+        if (record_->free_slots_ == 0)
+        {
+            throw std::runtime_error("No free hazard slot!");
+        }
+
+        const uint32_t index = static_cast<uint32_t>(__builtin_ctz(record_->free_slots_));
+        record_->free_slots_ &= ~(uint32_t{1} << index);
+        slot_ = &record_->slots_[index];
+        index_ = index;
+    }
+
+    HazardPointer(const HazardPointer&) = delete;
+
+    HazardPointer& operator=(const HazardPointer&) = delete;
+
+    ~HazardPointer()
+    {
+        slot_->store(nullptr, std::memory_order_release);
+        record_->free_slots_ |= uint32_t{1} << index_;
+    }
+
+    // Loads source until the published value is still current, the result is safe until reset or destruction
+    template <typename T>
+    [[nodiscard]] T* protect(const std::atomic<T*>& source) noexcept
+    {
+        T* ptr = source.load(std::memory_order_relaxed);
+        while (!try_protect(ptr, source))
+        {
+        }
+        return ptr;
+    }
+
+    // Publishes ptr, false (and ptr reloaded) when source changed meanwhile
+    template <typename T>
+    [[nodiscard]] bool try_protect(T*& ptr, const std::atomic<T*>& source) noexcept
+    {
+        T* published = ptr;
+        slot_->store(static_cast<const void*>(published), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        ptr = source.load(std::memory_order_acquire);
+        if (ptr != published)
+        {
+            slot_->store(nullptr, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // Publishes a pointer the caller knows to be live (e.g. protected by another hazard pointer)
+    void reset_protection(const void* ptr = nullptr) noexcept
+    {
+        slot_->store(ptr, std::memory_order_release);
+        if (ptr != nullptr)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+private:
+    hazard::HazardRecord* record_;
+    std::atomic<const void*>* slot_;
+    uint32_t index_;
+};
+
+// Reclaimed with delete once unprotected
+template <class Tag = DefaultHazardTag, typename T>
+void retire(T* object)
+{
+    static_assert(std::is_base_of_v<HazardObject, T>, "T must derive from HazardObject, or pass a deleter!");
+
+    object->retired_address_ = static_cast<const void*>(object);
+    object->reclaim_ = [](HazardObject* retired) { delete static_cast<T*>(retired); };
+
+    hazard::retire_object<Tag>(object);
+}
+
+// Reclaimed with deleter(ptr) once unprotected
+template <class Tag = DefaultHazardTag, typename T, typename Deleter>
+void retire(T* ptr, Deleter deleter)
+{
+    using Box = hazard::RetiredBox<T, Deleter>;
+
+    Box* box = new Box{ptr, std::move(deleter)};
+    box->retired_address_ = static_cast<const void*>(ptr);
+    box->reclaim_ = [](HazardObject* retired) {
+        Box* retired_box = static_cast<Box*>(retired);
+        retired_box->deleter_(retired_box->ptr_);
+        delete retired_box;
+    };
+
+    hazard::retire_object<Tag>(box);
+}
+
+// Scans now instead of at the threshold, e.g. before a quiescent period
+template <class Tag = DefaultHazardTag>
+void reclaim_retired()
+{
+    hazard::hazard_domain<Tag>().scan(hazard::local_record<Tag>());
+}
+
+template <class Tag = DefaultHazardTag>
+void set_retire_threshold(const size_t threshold) noexcept
+{
+    hazard::hazard_domain<Tag>().set_retire_threshold(threshold);
+}
+
+}  // namespace erturk::concurrency::reclamation
+
 #endif  // ERTURK_HAZARD_POINTERS_H
@@ -0,0 +1,630 @@
+#ifndef ERTURK_THREAD_CACHING_ALLOCATOR_H
+#define ERTURK_THREAD_CACHING_ALLOCATOR_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/*
+Size-class allocator with per-thread caches, a drop-in Allocator argument for BaseString and DynamicTypeBufferArray:
+  erturk::container::DynamicTypeBufferArray<int, erturk::allocator::ThreadCachingAllocator<int>>
+
+Small requests (up to MAX_SMALL_SIZE_) are rounded up to one of CLASS_COUNT_ size classes: 16 byte steps up to 128,
+then 4 classes per power of two.
+
+- Span        : SPAN_SIZE_ aligned block mapped with mmap, a header at the start (owner heap, size class) and equal
+                sized blocks after it. Masking a block address gives its header, deallocate needs no size.
+- ThreadHeap  : one per thread, a free list per size class plus a bump region of the last span. The fast paths are
+                a pop/push on the thread's own list, no atomics and no locks.
+- CentralDepot: one mutex protected stack of batches per size class. A thread whose list grows beyond two batches
+                hands one batch over, a thread with an empty list takes one, so a lock is taken once per batch.
+- Remote free : a block freed by another thread than its span owner is pushed on the owner's lock-free remote stack
+                (many producers, the owner takes the whole stack with one exchange when its list runs empty), blocks
+                return to the heap that carved them instead of piling up in a consumer thread.
+
+Larger requests get their own SPAN_SIZE_ aligned mapping with a large header, unmapped on deallocate.
+
+A heap outlives its thread: at thread exit its lists go to the depot and the heap is parked for the next new thread,
+remote frees to a parked heap wait there. Memory of spans is kept for reuse, it is not returned to the OS.
+*/
+namespace erturk::allocator
+{
+
+namespace thread_cache
+{
+
+inline constexpr size_t SPAN_SIZE_ = size_t{256} * 1024;
+inline constexpr size_t SPAN_HEADER_SIZE_ = 64;  // keeps blocks 16 byte aligned, large blocks 64 byte aligned
+inline constexpr size_t MAX_SMALL_SIZE_ = size_t{32} * 1024;
+inline constexpr size_t SMALL_STEP_CLASSES_ = 8;  // 16, 32, ..., 128
+inline constexpr size_t CLASS_COUNT_ = 40;         // + 4 classes for each power of two in (128, 32768]
+inline constexpr size_t LARGE_CLASS_ = CLASS_COUNT_;
+inline constexpr size_t MIN_ALIGNMENT_ = 16;
+
+struct FreeBlock
+{
+    FreeBlock* next_;
+    FreeBlock* next_batch_;  // only for the first block of a batch in the depot
+};
+
+struct ThreadHeap;
+
+struct SpanHeader
+{
+    ThreadHeap* owner_;  // nullptr for a large block
+    size_t size_class_;
+    size_t mapped_size_;
+};
+
+[[nodiscard]] constexpr size_t size_class(const size_t bytes) noexcept
+{
+    if (bytes <= 128)
+    {
+        return bytes == 0 ? 0 : (bytes + 15) / 16 - 1;
+    }
+
+    const size_t last = bytes - 1;
+    const size_t msb = std::bit_width(last) - 1;  // >= 7
+
+    return SMALL_STEP_CLASSES_ + (msb - 7) * 4 + ((last >> (msb - 2)) & 3);
+}
+
+[[nodiscard]] constexpr size_t class_size(const size_t size_class) noexcept
+{
+    if (size_class < SMALL_STEP_CLASSES_)
+    {
+        return (size_class + 1) * 16;
+    }
+
+    const size_t step = size_class - SMALL_STEP_CLASSES_;
+    return (5 + step % 4) << (7 + step / 4 - 2);
+}
+
+// Blocks moved between a thread and the depot at once, fewer for larger classes
+[[nodiscard]] constexpr size_t batch_size(const size_t size_class) noexcept
+{
+    const size_t count = (size_t{64} * 1024) / class_size(size_class);
+    return count < 2 ? 2 : (count > 32 ? 32 : count);
+}
+
+static_assert(size_class(MAX_SMALL_SIZE_) == CLASS_COUNT_ - 1 && class_size(CLASS_COUNT_ - 1) == MAX_SMALL_SIZE_,
+              "Size class table does not end at MAX_SMALL_SIZE_!");
+
+[[nodiscard]] inline SpanHeader* span_of(const void* ptr) noexcept
+{
+    return reinterpret_cast<SpanHeader*>(reinterpret_cast<uintptr_t>(ptr) & ~(SPAN_SIZE_ - 1));
+}
+
+// Maps bytes (a multiple of the page size) at a SPAN_SIZE_ aligned address
+[[nodiscard]] inline void* map_aligned(const size_t bytes) noexcept
+{
+    const size_t length = bytes + SPAN_SIZE_;
+
+    void* raw_memory = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (raw_memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(raw_memory);
+    const uintptr_t aligned = (begin + SPAN_SIZE_ - 1) & ~(SPAN_SIZE_ - 1);
+    const size_t head = aligned - begin;
+    const size_t tail = length - head - bytes;
+
+    // trim the over-mapping, only the aligned part stays mapped
+    if (head != 0)
+    {
+        ::munmap(raw_memory, head);
+    }
+    if (tail != 0)
+    {
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+struct FreeList
+{
+    FreeBlock* head_{nullptr};
+    size_t length_{0};
+
+    void push(FreeBlock* block) noexcept
+    {
+        block->next_ = head_;
+        head_ = block;
+        length_++;
+    }
+
+    [[nodiscard]] FreeBlock* pop() noexcept
+    {
+        FreeBlock* block = head_;
+        head_ = block->next_;
+        length_--;
+        return block;
+    }
+};
+
+struct BumpRegion
+{
+    unsigned char* next_{nullptr};
+    unsigned char* end_{nullptr};
+};
+
+struct alignas(64) ThreadHeap
+{
+    FreeList lists_[CLASS_COUNT_];
+    BumpRegion bumps_[CLASS_COUNT_];
+    ThreadHeap* next_parked_{nullptr};
+
+    alignas(64) std::atomic<FreeBlock*> remote_free_{nullptr};
+};
+
+class CentralDepot
+{
+public:
+    // first heads a null-terminated chain of blocks
+    void push_batch(const size_t size_class, FreeBlock* first) noexcept
+    {
+        Shelf& shelf = shelves_[size_class];
+        std::lock_guard<std::mutex> guard{shelf.lock_};
+
+        first->next_batch_ = shelf.batches_;
+        shelf.batches_ = first;
+    }
+
+    [[nodiscard]] FreeBlock* pop_batch(const size_t size_class) noexcept
+    {
+        Shelf& shelf = shelves_[size_class];
+        std::lock_guard<std::mutex> guard{shelf.lock_};
+
+        FreeBlock* first = shelf.batches_;
+        if (first != nullptr)
+        {
+            shelf.batches_ = first->next_batch_;
+        }
+        return first;
+    }
+
+    [[nodiscard]] ThreadHeap* acquire_heap() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> guard{heaps_lock_};
+
+            if (parked_heaps_ != nullptr)
+            {
+                ThreadHeap* heap = parked_heaps_;
+                parked_heaps_ = heap->next_parked_;
+                return heap;
+            }
+        }
+        return new (std::nothrow) ThreadHeap{};
+    }
+
+    void park_heap(ThreadHeap* heap) noexcept
+    {
+        std::lock_guard<std::mutex> guard{heaps_lock_};
+
+        heap->next_parked_ = parked_heaps_;
+        parked_heaps_ = heap;
+    }
+
+private:
+    struct alignas(64) Shelf
+    {
+        std::mutex lock_;
+        FreeBlock* batches_{nullptr};
+    };
+
+    Shelf shelves_[CLASS_COUNT_];
+
+    std::mutex heaps_lock_;
+    ThreadHeap* parked_heaps_{nullptr};
+};
+
+// Never destroyed, blocks may be freed by static destructors of other objects
+[[nodiscard]] inline CentralDepot& central_depot() noexcept
+{
+    static CentralDepot* depot = new CentralDepot{};
+    return *depot;
+}
+
+[[nodiscard]] inline size_t page_size() noexcept
+{
+    static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// Hands the first batch of the list over to the depot
+inline void flush_batch(ThreadHeap* heap, const size_t size_class) noexcept
+{
+    FreeList& list = heap->lists_[size_class];
+    const size_t count = batch_size(size_class);
+
+    FreeBlock* first = list.head_;
+    FreeBlock* last = first;
+    for (size_t idx = 1; idx < count; idx++)
+    {
+        last = last->next_;
+    }
+
+    list.head_ = last->next_;
+    list.length_ -= count;
+    last->next_ = nullptr;
+
+    central_depot().push_batch(size_class, first);
+}
+
+// Moves every block freed by other threads into the owner's lists
+inline void drain_remote_frees(ThreadHeap* heap) noexcept
+{
+    FreeBlock* block = heap->remote_free_.exchange(nullptr, std::memory_order_acquire);
+
+    while (block != nullptr)
+    {
+        FreeBlock* next = block->next_;
+        heap->lists_[span_of(block)->size_class_].push(block);
+        block = next;
+    }
+}
+
+// Carves up to a batch of blocks from the bump region, a new span is mapped when it is used up
+[[nodiscard]] inline bool carve_blocks(ThreadHeap* heap, const size_t size_class) noexcept
+{
+    BumpRegion& bump = heap->bumps_[size_class];
+    const size_t block_size = class_size(size_class);
+
+    if (bump.next_ == nullptr || bump.next_ + block_size > bump.end_)
+    {
+        void* span = map_aligned(SPAN_SIZE_);
+
+        if (span == nullptr)
+        {
+            return false;
+        }
+
+        ::new (span) SpanHeader{heap, size_class, SPAN_SIZE_};
+
+        bump.next_ = static_cast<unsigned char*>(span) + SPAN_HEADER_SIZE_;
+        bump.end_ = static_cast<unsigned char*>(span) + SPAN_SIZE_;
+    }
+
+    FreeList& list = heap->lists_[size_class];
+    const size_t count = batch_size(size_class);
+
+    for (size_t idx = 0; idx < count && bump.next_ + block_size <= bump.end_; idx++)
+    {
+        list.push(reinterpret_cast<FreeBlock*>(bump.next_));
+        bump.next_ += block_size;
+    }
+    return true;
+}
+
+[[nodiscard]] inline void* allocate_small(ThreadHeap* heap, const size_t size_class) noexcept
+{
+    FreeList& list = heap->lists_[size_class];
+
+    if (list.head_ == nullptr)
+    {
+        drain_remote_frees(heap);
+    }
+
+    if (list.head_ == nullptr)
+    {
+        FreeBlock* batch = central_depot().pop_batch(size_class);
+
+        if (batch != nullptr)
+        {
+            for (FreeBlock* block = batch; block != nullptr;)
+            {
+                FreeBlock* next = block->next_;
+                list.push(block);
+                block = next;
+            }
+        }
+        else if (!carve_blocks(heap, size_class))
+        {
+            return nullptr;
+        }
+    }
+    return list.pop();
+}
+
+inline void deallocate_small(ThreadHeap* heap, void* ptr, const SpanHeader* span) noexcept
+{
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+
+    if (span->owner_ != heap)
+    {
+        // Lock-free push on the owner's remote stack, the owner takes all of it at once
+        std::atomic<FreeBlock*>& remote_free = span->owner_->remote_free_;
+        FreeBlock* head = remote_free.load(std::memory_order_relaxed);
+        do
+        {
+            block->next_ = head;
+        } while (!remote_free.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+        return;
+    }
+
+    const size_t size_class = span->size_class_;
+    FreeList& list = heap->lists_[size_class];
+
+    list.push(block);
+
+    if (list.length_ > 2 * batch_size(size_class))
+    {
+        flush_batch(heap, size_class);
+    }
+}
+
+// Every cached block goes to the depot, the heap is parked for a later thread
+inline void release_heap(ThreadHeap* heap) noexcept
+{
+    drain_remote_frees(heap);
+
+    for (size_t size_class = 0; size_class < CLASS_COUNT_; size_class++)
+    {
+        FreeList& list = heap->lists_[size_class];
+        const size_t count = batch_size(size_class);
+
+        while (list.length_ >= count)
+        {
+            flush_batch(heap, size_class);
+        }
+
+        if (list.head_ != nullptr)
+        {
+            // a short batch is still a valid batch
+            list.head_->next_batch_ = nullptr;
+            central_depot().push_batch(size_class, list.head_);
+            list = FreeList{};
+        }
+    }
+
+    central_depot().park_heap(heap);
+}
+
+enum class HeapState : unsigned char
+{
+    None,
+    Active,
+    Released  // thread is exiting, its thread_local objects are being destroyed
+};
+
+struct HeapGuard
+{
+    ~HeapGuard();
+};
+
+inline thread_local ThreadHeap* local_heap_ = nullptr;
+inline thread_local HeapState local_heap_state_ = HeapState::None;
+
+inline HeapGuard::~HeapGuard()
+{
+    if (local_heap_ != nullptr)
+    {
+        release_heap(local_heap_);
+        local_heap_ = nullptr;
+    }
+    local_heap_state_ = HeapState::Released;
+}
+
+// nullptr once the thread's heap is released (thread exit) or when no heap could be created
+[[nodiscard]] inline ThreadHeap* local_heap() noexcept
+{
+    if (local_heap_state_ == HeapState::Active) [[likely]]
+    {
+        return local_heap_;
+    }
+
+    if (local_heap_state_ == HeapState::Released)
+    {
+        return nullptr;
+    }
+
+    ThreadHeap* heap = central_depot().acquire_heap();
+    if (heap == nullptr)
+    {
+        return nullptr;
+    }
+
+    // registers the release at thread exit
+    thread_local HeapGuard guard;
+    (void)guard;
+
+    local_heap_ = heap;
+    local_heap_state_ = HeapState::Active;
+    return heap;
+}
+
+[[nodiscard]] inline void* allocate_large(const size_t bytes) noexcept
+{
+    const size_t page = page_size();
+    const size_t mapped_size = (bytes + SPAN_HEADER_SIZE_ + page - 1) & ~(page - 1);
+
+    void* span = map_aligned(mapped_size);
+
+    if (span == nullptr)
+    {
+        return nullptr;
+    }
+
+    ::new (span) SpanHeader{nullptr, LARGE_CLASS_, mapped_size};
+
+    return static_cast<unsigned char*>(span) + SPAN_HEADER_SIZE_;
+}
+
+[[nodiscard]] inline void* allocate(const size_t bytes) noexcept
+{
+    if (bytes > MAX_SMALL_SIZE_)
+    {
+        return allocate_large(bytes);
+    }
+
+    ThreadHeap* heap = local_heap();
+
+    if (heap != nullptr) [[likely]]
+    {
+        return allocate_small(heap, size_class(bytes));
+    }
+
+    // No heap of our own (thread exit), borrow a parked one for this call
+    heap = central_depot().acquire_heap();
+    if (heap == nullptr)
+    {
+        return nullptr;
+    }
+
+    void* ptr = allocate_small(heap, size_class(bytes));
+    release_heap(heap);
+    return ptr;
+}
+
+inline void deallocate(void* ptr) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    SpanHeader* span = span_of(ptr);
+
+    if (span->size_class_ == LARGE_CLASS_)
+    {
+        ::munmap(span, span->mapped_size_);
+        return;
+    }
+
+    // a thread without heap frees every block remotely
+    deallocate_small(local_heap(), ptr, span);
+}
+
+// Bytes usable at ptr, at least the requested size
+[[nodiscard]] inline size_t usable_size(const void* ptr) noexcept
+{
+    const SpanHeader* span = span_of(ptr);
+
+    return span->size_class_ == LARGE_CLASS_ ? span->mapped_size_ - SPAN_HEADER_SIZE_ : class_size(span->size_class_);
+}
+
+}  // namespace thread_cache
+
+template <class T>
+class ThreadCachingAllocator
+{
+    static_assert(alignof(T) <= thread_cache::MIN_ALIGNMENT_, "T is over-aligned for ThreadCachingAllocator!");
+
+public:
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer_type;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T value_type;
+
+public:
+    constexpr ThreadCachingAllocator() noexcept = default;
+
+    template <class U>
+    constexpr ThreadCachingAllocator(const ThreadCachingAllocator<U>&) noexcept
+    {
+    }
+
+    static pointer_type allocate(const size_t count) noexcept
+    {
+        if (count == 0 || count > MAX_COUNT_)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(thread_cache::allocate(count * sizeof(T)));
+    }
+
+    /**
+     *  @brief  Resize memory with realloc semantics, the block is kept when its size class already fits new_count.
+     *          Bytes are moved without constructors, only for trivially relocatable T.
+     */
+    static pointer_type reallocate(T* ptr, const size_t old_count, const size_t new_count) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return allocate(new_count);
+        }
+
+        if (new_count == 0 || new_count > MAX_COUNT_)
+        {
+            return nullptr;
+        }
+
+        if (new_count * sizeof(T) <= thread_cache::usable_size(ptr))
+        {
+            return ptr;
+        }
+
+        T* new_ptr = allocate(new_count);
+        if (new_ptr == nullptr)
+        {
+            return nullptr;
+        }
+
+        std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr),
+                    (old_count < new_count ? old_count : new_count) * sizeof(T));
+        deallocate(ptr);
+
+        return new_ptr;
+    }
+
+    static void deallocate(T* ptr, const size_t) noexcept
+    {
+        thread_cache::deallocate(static_cast<void*>(ptr));
+    }
+
+    static void deallocate(T* ptr) noexcept
+    {
+        thread_cache::deallocate(static_cast<void*>(ptr));
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = ThreadCachingAllocator<U>;
+    };
+
+    template <typename U, typename... Args>
+    static void construct(U* addr, Args&&... args)
+    {
+        if (addr != nullptr)
+        {
+            new (addr) U{std::forward<Args>(args)...};  // construct at
+        }
+    }
+
+    template <typename U>
+    static void destroy(U* addr)
+    {
+        if (addr != nullptr)
+        {
+            addr->~U();
+        }
+    }
+
+    template <class U>
+    [[nodiscard]] constexpr bool operator==(const ThreadCachingAllocator<U>&) const noexcept
+    {
+        return true;  // stateless, any instance frees any block
+    }
+
+private:
+    static constexpr size_t MAX_COUNT_ = (static_cast<size_t>(-1) - thread_cache::SPAN_SIZE_) / sizeof(T);
+};
+
+}  // namespace erturk::allocator
+
+#endif  // ERTURK_THREAD_CACHING_ALLOCATOR_H
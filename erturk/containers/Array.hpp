@@ -192,6 +192,16 @@ public:
         return SIZE;
     }
 
+    [[nodiscard]] T* data() noexcept
+    {
+        return buffer_;
+    }
+
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return buffer_;
+    }
+
 private:
     T buffer_[SIZE];
 
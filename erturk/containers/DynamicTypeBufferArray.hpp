@@ -2,9 +2,15 @@
 #define ERTURK_DYNAMIC_ARRAY_H
 
 #include "../allocator/AlignedSystemAllocator.hpp"
+#include "../allocator/AllocatorTraits.hpp"
 #include "../memory/TypeBufferMemory.hpp"
 #include "../meta_types/TypeTrait.hpp"
+#include "GrowthPolicy.hpp"
+#include "ranges/InitializerList.hpp"
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace erturk::container
 {
@@ -12,16 +18,24 @@ namespace erturk::container
 // For simplicity:
 // - No SSO
 // - No COW
-
-template <typename T, typename Allocator = erturk::allocator::AlignedSystemAllocator<T, alignof(T)>>
-class DynamicTypeBufferArray final
+// - Growth follows Growth (see GrowthPolicy.hpp)
+// - Trivially relocatable elements (meta::is_trivially_relocatable) are resized with realloc and shifted with memmove
+//   by insert/erase, other elements are moved one by one
+// - The allocator is an instance (see allocator/AllocatorTraits.hpp), an empty allocator takes no space
+
+template <typename T, typename Allocator = erturk::allocator::AlignedSystemAllocator<T, alignof(T)>,
+          typename Growth = DefaultGrowth>
+class DynamicTypeBufferArray final : private erturk::allocator::AllocatorHolder<Allocator>
 {
     static_assert((erturk::meta::is_copy_constructible<T>::value || erturk::meta::is_move_constructible<T>::value),
                   "T must be copy constructible or move constructible!");
 
 private:
     static constexpr size_t DEFAULT_CAPACITY_ = 1;
-    static constexpr unsigned char DEFAULT_MULTIPLICATION = 2;
+    static constexpr bool TRIVIALLY_RELOCATABLE_ = erturk::meta::is_trivially_relocatable<T>::value;
+
+    using AllocatorHolder = erturk::allocator::AllocatorHolder<Allocator>;
+    using AllocatorTraits = erturk::allocator::AllocatorTraits<Allocator>;
 
 public:
     class Iterator
@@ -66,8 +80,9 @@ public:
         T* t_ptr_;
     };
 
-    explicit DynamicTypeBufferArray() noexcept(false)
-        : capacity_{DEFAULT_CAPACITY_}, size_{0}, typeBufferArrayPtr_{Allocator::allocate(capacity_)}
+    explicit DynamicTypeBufferArray(const Allocator& allocator = Allocator{}) noexcept(false)
+        : AllocatorHolder{allocator}, capacity_{DEFAULT_CAPACITY_}, size_{0},
+          typeBufferArrayPtr_{this->allocator_instance().allocate(capacity_)}
     {
         if (typeBufferArrayPtr_ == nullptr)
         {
@@ -75,8 +90,10 @@ public:
         }
     }
 
-    explicit DynamicTypeBufferArray(const T& tVal, const size_t cap = DEFAULT_CAPACITY_) noexcept(false)
-        : capacity_{cap}, size_{0}, typeBufferArrayPtr_{Allocator::allocate(capacity_)}
+    explicit DynamicTypeBufferArray(const T& tVal, const size_t cap = DEFAULT_CAPACITY_,
+                                    const Allocator& allocator = Allocator{}) noexcept(false)
+        : AllocatorHolder{allocator}, capacity_{cap}, size_{cap},
+          typeBufferArrayPtr_{this->allocator_instance().allocate(capacity_)}
     {
         if (typeBufferArrayPtr_ == nullptr)
         {
@@ -88,10 +105,26 @@ public:
                                                            erturk::type_buffer_memory::InstantiatePolicy::Copy);
     }
 
+    explicit DynamicTypeBufferArray(const erturk::range::InitializerList<T>& list,
+                                    const Allocator& allocator = Allocator{}) noexcept(false)
+        : AllocatorHolder{allocator}, capacity_{list.size()}, size_{0},
+          typeBufferArrayPtr_{this->allocator_instance().allocate(capacity_)}
+    {
+        if (typeBufferArrayPtr_ == nullptr && capacity_ != 0)
+        {
+            throw std::runtime_error("Failed to allocate memory!");
+        }
+
+        erturk::type_buffer_memory::emplace_type_buffers_copy_n<T, T*>(list.begin(), list.size(), typeBufferArrayPtr_);
+        size_ = list.size();
+    }
+
     DynamicTypeBufferArray(const DynamicTypeBufferArray& other) noexcept(false)
-        : capacity_(other.capacity_), size_(other.size_), typeBufferArrayPtr_(Allocator::allocate(capacity_))
+        : AllocatorHolder{AllocatorTraits::select_on_copy_construction(other.get_allocator())},
+          capacity_(other.capacity_), size_(other.size_),
+          typeBufferArrayPtr_(this->allocator_instance().allocate(capacity_))
     {
-        if (typeBufferArrayPtr_ == nullptr)
+        if (typeBufferArrayPtr_ == nullptr && capacity_ != 0)
         {
             throw std::runtime_error("Failed to allocate memory!");
         }
@@ -101,19 +134,20 @@ public:
             erturk::type_buffer_memory::InstantiatePolicy::Copy);
     }
 
-    // Take over ownership
+    // Take over ownership, the allocator is copied along with the buffer
     DynamicTypeBufferArray(DynamicTypeBufferArray&& other) noexcept
-        : capacity_(other.capacity_), size_(other.size_), typeBufferArrayPtr_(other.typeBufferArrayPtr_)
+        : AllocatorHolder{other.get_allocator()}, capacity_(other.capacity_), size_(other.size_),
+          typeBufferArrayPtr_(other.typeBufferArrayPtr_)
     {
         other.typeBufferArrayPtr_ = nullptr;
         other.size_ = 0;
-        other.capacity_ = DEFAULT_CAPACITY_;
+        other.capacity_ = 0;
     }
 
     ~DynamicTypeBufferArray()
     {
         clear();
-        Allocator::deallocate(typeBufferArrayPtr_);
+        this->allocator_instance().deallocate(typeBufferArrayPtr_, capacity_);
         typeBufferArrayPtr_ = nullptr;
     }
 
@@ -125,53 +159,112 @@ public:
         if (this != &other)
         {
             clear();
-            Allocator::deallocate(typeBufferArrayPtr_);
+            this->allocator_instance().deallocate(typeBufferArrayPtr_, capacity_);
             typeBufferArrayPtr_ = nullptr;
+            capacity_ = 0;
 
-            size_ = other.size_;
-            capacity_ = other.capacity_;
+            if constexpr (AllocatorTraits::propagate_on_copy_assignment)
+            {
+                this->allocator_instance() = other.get_allocator();
+            }
 
             // apply deep element copy
-            typeBufferArrayPtr_ = Allocator::allocate(capacity_);
+            typeBufferArrayPtr_ = this->allocator_instance().allocate(other.capacity_);
 
-            if (typeBufferArrayPtr_ == nullptr)
+            if (typeBufferArrayPtr_ == nullptr && other.capacity_ != 0)
             {
                 throw std::runtime_error("Failed to allocate memory!");
             }
 
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+
             // Copy elements from (other ptrToBuffer_ to other ptrToBuffer_ + size) into ptrToBuffer_
-            erturk::type_buffer_memory::emplace_type_buffers_copy(
+            erturk::type_buffer_memory::emplace_type_buffers_copy<T, T*>(
                 other.typeBufferArrayPtr_, other.typeBufferArrayPtr_ + other.size_, typeBufferArrayPtr_,
                 erturk::type_buffer_memory::InstantiatePolicy::Copy);
         }
         return *this;
     }
 
-    // Take over ownership
-    DynamicTypeBufferArray& operator=(DynamicTypeBufferArray&& other) noexcept
+    // Take over ownership, the elements are moved one by one when the allocators differ and do not propagate
+    DynamicTypeBufferArray& operator=(DynamicTypeBufferArray&& other) noexcept(
+        AllocatorTraits::propagate_on_move_assignment || AllocatorTraits::is_always_equal)
     {
-        clear();
-        Allocator::deallocate(typeBufferArrayPtr_);
+        if (this != &other)
+        {
+            if constexpr (!AllocatorTraits::propagate_on_move_assignment && !AllocatorTraits::is_always_equal)
+            {
+                if (!AllocatorTraits::equal(this->allocator_instance(), other.get_allocator()))
+                {
+                    clear();
+                    reserve(other.size_);
+
+                    erturk::type_buffer_memory::emplace_type_buffers_copy<T, T*>(
+                        other.typeBufferArrayPtr_, other.typeBufferArrayPtr_ + other.size_, typeBufferArrayPtr_,
+                        erturk::type_buffer_memory::InstantiatePolicy::Move);
+                    size_ = other.size_;
+
+                    other.clear();
+                    return *this;
+                }
+            }
 
-        size_ = other.size_;
-        capacity_ = other.capacity_;
-        typeBufferArrayPtr_ = other.typeBufferArrayPtr_;
+            clear();
+            this->allocator_instance().deallocate(typeBufferArrayPtr_, capacity_);
 
-        other.size_ = 0;
-        other.capacity_ = DEFAULT_CAPACITY_;
-        other.typeBufferArrayPtr_ = nullptr;
+            if constexpr (AllocatorTraits::propagate_on_move_assignment)
+            {
+                this->allocator_instance() = std::move(other.allocator_instance());
+            }
+
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            typeBufferArrayPtr_ = other.typeBufferArrayPtr_;
+
+            other.size_ = 0;
+            other.capacity_ = 0;
+            other.typeBufferArrayPtr_ = nullptr;
+        }
         return *this;
     }
 
+    // Allocators are swapped when they propagate on swap, otherwise they must be equal
+    void swap(DynamicTypeBufferArray& other) noexcept
+    {
+        if constexpr (AllocatorTraits::propagate_on_swap)
+        {
+            std::swap(this->allocator_instance(), other.allocator_instance());
+        }
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(typeBufferArrayPtr_, other.typeBufferArrayPtr_);
+    }
+
+    [[nodiscard]] Allocator get_allocator() const noexcept
+    {
+        return this->allocator_instance();
+    }
+
     void push_back(const T& tVal)
     {
         static_assert(erturk::meta::is_copy_constructible<T>::value, "T must be copy constructible!");
 
         if (size_ >= capacity_)
         {
-            expand_allocation(capacity_);
+            if (is_element(&tVal))
+            {
+                // tVal lives in the buffer that is about to be relocated
+                T copy{tVal};
+                expand_allocation(size_ + 1);
+                erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_, std::move(copy));
+                size_++;
+                return;
+            }
+            expand_allocation(size_ + 1);
         }
-        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_++, tVal);
+        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_, tVal);
+        size_++;
     }
 
     void push_back(T&& tVal)
@@ -180,9 +273,18 @@ public:
 
         if (size_ >= capacity_)
         {
-            expand_allocation(capacity_);
+            if (is_element(&tVal))
+            {
+                T moved{std::move(tVal)};
+                expand_allocation(size_ + 1);
+                erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_, std::move(moved));
+                size_++;
+                return;
+            }
+            expand_allocation(size_ + 1);
         }
-        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_++, std::move(tVal));
+        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_, std::move(tVal));
+        size_++;
     }
 
     template <typename... Args>
@@ -190,22 +292,161 @@ public:
     {
         if (size_ >= capacity_)
         {
-            expand_allocation(capacity_);
+            expand_allocation(size_ + 1);
+        }
+        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_, std::forward<Args>(args)...);
+        size_++;
+    }
+
+    // No capacity check, the caller guarantees size() < capacity() (e.g. a loop after reserve)
+    template <typename... Args>
+    void emplace_back_unchecked(Args&&... args)
+    {
+        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_, std::forward<Args>(args)...);
+        size_++;
+    }
+
+    // Appends [first, last) with one capacity check and one bulk construct, the range may be part of this array
+    template <typename InputIt>
+    void append(InputIt first, const InputIt last)
+    {
+        const size_t count = distance(first, last);
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (size_ + count > capacity_)
+        {
+            if constexpr (std::is_convertible_v<InputIt, const T*>)
+            {
+                if (is_element(first))
+                {
+                    // Rebase the source onto the relocated buffer
+                    const size_t offset = first - typeBufferArrayPtr_;
+                    expand_allocation(size_ + count);
+                    first = typeBufferArrayPtr_ + offset;
+                }
+                else
+                {
+                    expand_allocation(size_ + count);
+                }
+            }
+            else
+            {
+                expand_allocation(size_ + count);
+            }
         }
-        erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + size_++, std::forward<Args>(args)...);
+
+        erturk::type_buffer_memory::emplace_type_buffers_copy_n<T, T*>(first, count, typeBufferArrayPtr_ + size_);
+        size_ += count;
+    }
+
+    void append(const Iterator first, const Iterator last)
+    {
+        append(static_cast<const T*>(first.get()), static_cast<const T*>(last.get()));
+    }
+
+    // Replaces the content with count copies of value
+    void assign(const size_t count, const T& value)
+    {
+        if (is_element(&value))
+        {
+            T copy{value};
+            assign(count, copy);
+            return;
+        }
+
+        clear();
+
+        if (count > capacity_)
+        {
+            // Nothing to keep, a fresh block instead of relocating the old one
+            this->allocator_instance().deallocate(typeBufferArrayPtr_, capacity_);
+            typeBufferArrayPtr_ = nullptr;
+            capacity_ = 0;
+            reallocate(count);
+        }
+
+        erturk::type_buffer_memory::emplace_type_buffers_n(typeBufferArrayPtr_, count, value,
+                                                           erturk::type_buffer_memory::InstantiatePolicy::Copy);
+        size_ = count;
+    }
+
+    // New elements are value initialized
+    void resize(const size_t count)
+    {
+        if (count <= size_)
+        {
+            destruct_tail(count);
+            return;
+        }
+
+        if (count > capacity_)
+        {
+            expand_allocation(count);
+        }
+
+        erturk::type_buffer_memory::emplace_type_buffers_n<T>(typeBufferArrayPtr_ + size_, count - size_);
+        size_ = count;
+    }
+
+    void resize(const size_t count, const T& value)
+    {
+        if (count <= size_)
+        {
+            destruct_tail(count);
+            return;
+        }
+
+        if (is_element(&value))
+        {
+            T copy{value};
+            resize(count, copy);
+            return;
+        }
+
+        if (count > capacity_)
+        {
+            expand_allocation(count);
+        }
+
+        erturk::type_buffer_memory::emplace_type_buffers_n(typeBufferArrayPtr_ + size_, count - size_, value,
+                                                           erturk::type_buffer_memory::InstantiatePolicy::Copy);
+        size_ = count;
     }
 
     void reserve(const size_t new_capacity)
     {
         if (new_capacity > capacity_)
         {
-            expand_allocation(new_capacity);
+            reallocate(new_capacity);
+        }
+    }
+
+    // Releases unused capacity, an empty array frees its buffer
+    void shrink_to_fit()
+    {
+        if (size_ == capacity_)
+        {
+            return;
+        }
+
+        if (size_ == 0)
+        {
+            this->allocator_instance().deallocate(typeBufferArrayPtr_, capacity_);
+            typeBufferArrayPtr_ = nullptr;
+            capacity_ = 0;
+            return;
         }
+
+        reallocate(size_);
     }
 
     [[nodiscard]] T& operator[](const size_t index) noexcept(false)
     {
-        if (index > size_)
+        if (index >= size_)
         {
             throw std::runtime_error("Invalid Index!");
         }
@@ -214,7 +455,7 @@ public:
 
     [[nodiscard]] const T& operator[](const size_t index) const noexcept(false)
     {
-        if (index > size_)
+        if (index >= size_)
         {
             throw std::runtime_error("Invalid Index!");
         }
@@ -226,6 +467,17 @@ public:
         return size_;
     }
 
+    // Contiguous elements, nullptr before the first allocation
+    [[nodiscard]] T* data() noexcept
+    {
+        return typeBufferArrayPtr_;
+    }
+
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return typeBufferArrayPtr_;
+    }
+
     [[nodiscard]] size_t capacity() const
     {
         return capacity_;
@@ -267,37 +519,108 @@ public:
             return Iterator{nullptr};
         }
 
-        size_t insert_index = iterator.get() - typeBufferArrayPtr_;
+        const size_t insert_index = iterator.get() - typeBufferArrayPtr_;
 
-        if (size_ >= capacity_)
+        if (is_element(&value))
         {
-            size_t new_capacity = capacity_ * DEFAULT_MULTIPLICATION;
-            T* new_buffer = Allocator::allocate(new_capacity);
+            // value would be shifted or relocated below
+            T copy{value};
+            return insert_at(insert_index, std::move(copy));
+        }
+        return insert_at(insert_index, value);
+    }
 
-            if (new_buffer == nullptr)
+    Iterator erase(const Iterator iterator)
+    {
+        if (iterator.get() < typeBufferArrayPtr_ || iterator.get() >= typeBufferArrayPtr_ + size_)
+        {
+            return Iterator{nullptr};
+        }
+
+        size_t erase_index = iterator.get() - typeBufferArrayPtr_;
+
+        erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + erase_index);
+
+        if constexpr (TRIVIALLY_RELOCATABLE_)
+        {
+            // Close the gap in one go
+            std::memmove(static_cast<void*>(typeBufferArrayPtr_ + erase_index),
+                         static_cast<const void*>(typeBufferArrayPtr_ + erase_index + 1),
+                         (size_ - erase_index - 1) * sizeof(T));
+        }
+        else
+        {
+            for (size_t idx = erase_index; idx < size_ - 1; idx++)
             {
-                throw std::runtime_error("Failed to allocate memory!");
+                erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + idx,
+                                                         std::move(typeBufferArrayPtr_[idx + 1]));
+                erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + idx + 1);
             }
+        }
 
-            // Emplace from base address to base address + insert_index into new buffer
-            erturk::type_buffer_memory::emplace_type_buffers_copy<T, T*>(
-                typeBufferArrayPtr_, typeBufferArrayPtr_ + insert_index, new_buffer);
-
-            // Emplace insert value
-            erturk::type_buffer_memory::construct_at(new_buffer + insert_index, value);
+        size_--;
+        return Iterator{typeBufferArrayPtr_ + erase_index};
+    }
 
-            // Emplace from (base address + insert_index) to (base address + size) into (new_buffer + insert_index + 1)
-            erturk::type_buffer_memory::emplace_type_buffers_copy<T, T*>(
-                typeBufferArrayPtr_ + insert_index, typeBufferArrayPtr_ + size_, new_buffer + insert_index + 1);
+private:
+    [[nodiscard]] bool is_element(const T* addr) const noexcept
+    {
+        return addr >= typeBufferArrayPtr_ && addr < typeBufferArrayPtr_ + size_;
+    }
 
-            for (size_t idx = 0; idx < size_; idx++)
+    template <typename InputIt>
+    [[nodiscard]] static size_t distance(InputIt first, const InputIt last)
+    {
+        if constexpr (requires { last - first; })
+        {
+            return static_cast<size_t>(last - first);
+        }
+        else
+        {
+            size_t count = 0;
+            while (first != last)
             {
-                erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + idx);
+                ++first;
+                count++;
             }
-            Allocator::deallocate(typeBufferArrayPtr_);
+            return count;
+        }
+    }
 
-            typeBufferArrayPtr_ = new_buffer;
-            capacity_ = new_capacity;
+    void destruct_tail(const size_t new_size) noexcept
+    {
+        for (size_t idx = new_size; idx < size_; idx++)
+        {
+            erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + idx);
+        }
+        size_ = new_size;
+    }
+
+    template <typename U>
+    Iterator insert_at(const size_t insert_index, U&& value) noexcept(false)
+    {
+        if (size_ >= capacity_)
+        {
+            expand_allocation(size_ + 1);
+        }
+
+        if constexpr (TRIVIALLY_RELOCATABLE_)
+        {
+            const size_t tail_size = (size_ - insert_index) * sizeof(T);
+
+            // Open the gap in one go, the gap is raw memory afterwards
+            std::memmove(static_cast<void*>(typeBufferArrayPtr_ + insert_index + 1),
+                         static_cast<const void*>(typeBufferArrayPtr_ + insert_index), tail_size);
+            try
+            {
+                erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + insert_index, std::forward<U>(value));
+            }
+            catch (...)
+            {
+                std::memmove(static_cast<void*>(typeBufferArrayPtr_ + insert_index),
+                             static_cast<const void*>(typeBufferArrayPtr_ + insert_index + 1), tail_size);
+                throw;
+            }
         }
         else
         {
@@ -312,58 +635,35 @@ public:
                 idx--;
             }
 
-            erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + insert_index, value);
+            erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + insert_index, std::forward<U>(value));
         }
+
         size_++;
         return Iterator{typeBufferArrayPtr_ + insert_index};  // return inserted position iterator
     }
 
-    Iterator erase(const Iterator iterator)
+    void expand_allocation(const size_t required_capacity) noexcept(false)
     {
-        if (iterator.get() < typeBufferArrayPtr_ || iterator.get() >= typeBufferArrayPtr_ + size_)
-        {
-            return Iterator{nullptr};
-        }
-
-        size_t erase_index = iterator.get() - typeBufferArrayPtr_;
-
-        erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + erase_index);
-
-        for (size_t idx = erase_index; idx < size_ - 1; idx++)
-        {
-            erturk::type_buffer_memory::construct_at(typeBufferArrayPtr_ + idx,
-                                                     std::move(typeBufferArrayPtr_[idx + 1]));
-            erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + idx + 1);
-        }
-
-        size_--;
-        return Iterator{typeBufferArrayPtr_ + erase_index};
+        reallocate(Growth::next_capacity(capacity_, required_capacity));
     }
 
-private:
-    void expand_allocation(size_t new_capacity, size_t times = DEFAULT_MULTIPLICATION) noexcept(false)
+    void reallocate(const size_t new_capacity) noexcept(false)
     {
-        if (new_capacity > capacity_)
+        if (typeBufferArrayPtr_ == nullptr)
         {
-            T* new_buffer = Allocator::allocate(new_capacity * times);
+            typeBufferArrayPtr_ = this->allocator_instance().allocate(new_capacity);
 
             if (typeBufferArrayPtr_ == nullptr)
             {
                 throw std::runtime_error("Failed to allocate memory!");
             }
-
-            erturk::type_buffer_memory::emplace_type_buffers_copy<T, T*>(typeBufferArrayPtr_,
-                                                                         typeBufferArrayPtr_ + size_, new_buffer);
-
-            for (size_t idx = 0; idx < size_; idx++)
-            {
-                erturk::type_buffer_memory::destruct_at(typeBufferArrayPtr_ + idx);
-            }
-            Allocator::deallocate(typeBufferArrayPtr_);
-
-            typeBufferArrayPtr_ = new_buffer;
-            capacity_ = new_capacity;
         }
+        else
+        {
+            typeBufferArrayPtr_ = growth::relocate_buffer<T, Allocator>(this->allocator_instance(), typeBufferArrayPtr_,
+                                                                        size_, capacity_, new_capacity);
+        }
+        capacity_ = new_capacity;
     }
 
 private:
@@ -0,0 +1,127 @@
+#ifndef ERTURK_GROWTH_POLICY_H
+#define ERTURK_GROWTH_POLICY_H
+
+#include "../memory/TypeBufferMemory.hpp"
+#include "../meta_types/TypeTrait.hpp"
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+Capacity growth shared by String and DynamicTypeBufferArray.
+
+GeometricGrowth<NUMERATOR, DENOMINATOR>: the next capacity is current * NUMERATOR / DENOMINATOR, at least the required
+capacity. 2/1 is the default, 3/2 trades a few more reallocations for less slack and lets the allocator reuse freed
+blocks for later growth steps.
+
+relocate_buffer moves the live elements into a block of another capacity:
+- trivially relocatable T (meta::is_trivially_relocatable) and an allocator with reallocate(ptr, old_count, new_count):
+  the block is resized with realloc, grown in place when the neighbouring memory is free, large blocks are remapped
+  (mremap) instead of copied.
+- trivially relocatable T otherwise: a new block is allocated and the bytes are copied, no constructor or destructor
+  runs.
+- otherwise: a new block is allocated, elements are moved (nothrow move) or copied into it, the old ones are destructed
+  and the old block is released.
+*/
+namespace erturk::container
+{
+
+template <size_t NUMERATOR = 2, size_t DENOMINATOR = 1>
+struct GeometricGrowth
+{
+    static_assert(DENOMINATOR > 0 && NUMERATOR > DENOMINATOR, "Growth factor must be greater than 1!");
+
+    [[nodiscard]] static constexpr size_t next_capacity(const size_t current, const size_t required) noexcept
+    {
+        constexpr size_t LIMIT_ = static_cast<size_t>(-1) / NUMERATOR;
+
+        const size_t grown = current > LIMIT_ ? static_cast<size_t>(-1) : current * NUMERATOR / DENOMINATOR;
+
+        return grown > required ? grown : required;
+    }
+};
+
+using DefaultGrowth = GeometricGrowth<2, 1>;
+
+namespace growth
+{
+
+template <typename T, typename Allocator>
+inline constexpr bool can_reallocate_ =
+    erturk::meta::is_trivially_relocatable<T>::value &&
+    requires(Allocator& allocator, T* ptr, const size_t count) { allocator.reallocate(ptr, count, count); };
+
+// Moves size live elements of buffer (capacity elements) into a block of new_capacity elements (not less than size).
+// Returns the new block, on failure it throws and buffer is left as it was. buffer belongs to allocator.
+template <typename T, typename Allocator>
+[[nodiscard]] T* relocate_buffer(Allocator& allocator, T* buffer, const size_t size, const size_t capacity,
+                                 const size_t new_capacity) noexcept(false)
+{
+    if constexpr (can_reallocate_<T, Allocator>)
+    {
+        T* new_buffer = allocator.reallocate(buffer, capacity, new_capacity);
+
+        if (new_buffer == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate memory!");
+        }
+        return new_buffer;
+    }
+    else if constexpr (erturk::meta::is_trivially_relocatable<T>::value)
+    {
+        T* new_buffer = allocator.allocate(new_capacity);
+
+        if (new_buffer == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate memory!");
+        }
+
+        if (size != 0)
+        {
+            std::memcpy(static_cast<void*>(new_buffer), static_cast<const void*>(buffer), size * sizeof(T));
+        }
+        allocator.deallocate(buffer, capacity);
+
+        return new_buffer;
+    }
+    else
+    {
+        T* new_buffer = allocator.allocate(new_capacity);
+
+        if (new_buffer == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate memory!");
+        }
+
+        // Moving is only safe when it cannot throw halfway, the source would be left with moved-from elements
+        constexpr auto policy =
+            std::is_nothrow_move_constructible_v<T> || !erturk::meta::is_copy_constructible<T>::value
+                ? erturk::type_buffer_memory::InstantiatePolicy::Move
+                : erturk::type_buffer_memory::InstantiatePolicy::Copy;
+
+        try
+        {
+            erturk::type_buffer_memory::emplace_type_buffers_copy<T, T*>(buffer, buffer + size, new_buffer, policy);
+        }
+        catch (...)
+        {
+            allocator.deallocate(new_buffer, new_capacity);
+            throw;
+        }
+
+        for (size_t idx = 0; idx < size; idx++)
+        {
+            erturk::type_buffer_memory::destruct_at(buffer + idx);
+        }
+        allocator.deallocate(buffer, capacity);
+
+        return new_buffer;
+    }
+}
+
+}  // namespace growth
+
+}  // namespace erturk::container
+
+#endif  // ERTURK_GROWTH_POLICY_H
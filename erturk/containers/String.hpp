@@ -2,19 +2,29 @@
 #define ERTURK_STRING_H
 
 #include "../allocator/AlignedSystemAllocator.hpp"
+#include "../allocator/AllocatorTraits.hpp"
 #include "../memory/Memory.hpp"
+#include "../memory/VectorizedSearch.hpp"
 #include "../memory/TypeBufferMemory.hpp"
 #include "../meta_types/TypeTrait.hpp"
+#include "GrowthPolicy.hpp"
+#include "views/StringView.hpp"
+#include <cstring>
 #include <stdexcept>
+#include <utility>
 
 namespace erturk::container
 {
 
-// For simplicity:
-// - No SSO
-// - No COW
-template <typename CharT, typename Allocator = erturk::allocator::AlignedSystemAllocator<CharT, alignof(CharT)>>
-class BaseString final
+// Small string optimization: strings of up to LOCAL_CAPACITY_ - 1 chars (23 for char on 64-bit) live in an inline
+// buffer that overlays the heap pointer/capacity, so short strings and default construction never allocate. The high
+// bit of length_ marks heap storage. There is no self-pointer, a move copies the object bytes and resets the source.
+// No COW.
+// Heap growth follows Growth (see GrowthPolicy.hpp), heap buffers are resized with realloc when the allocator has it.
+// The allocator is an instance (see allocator/AllocatorTraits.hpp), an empty allocator takes no space.
+template <typename CharT, typename Allocator = erturk::allocator::AlignedSystemAllocator<CharT, alignof(CharT)>,
+          typename Growth = DefaultGrowth>
+class BaseString final : private erturk::allocator::AllocatorHolder<Allocator>
 {
     static_assert((erturk::meta::is_same<CharT, char>::value || erturk::meta::is_same<CharT, char8_t>::value
                    || erturk::meta::is_same<CharT, wchar_t>::value || erturk::meta::is_same<CharT, char16_t>::value
@@ -23,8 +33,11 @@ class BaseString final
 
 private:
     static constexpr size_t TERMINATOR_ = 1;
-    static constexpr size_t DEFAULT_CAPACITY_ = TERMINATOR_;
-    static constexpr size_t DEFAULT_MULTIPLICATION = 2;
+    static constexpr size_t LOCAL_CAPACITY_ = (3 * sizeof(void*)) / sizeof(CharT);  // with terminator
+    static constexpr size_t HEAP_FLAG_ = size_t{1} << (sizeof(size_t) * 8 - 1);
+
+    using AllocatorHolder = erturk::allocator::AllocatorHolder<Allocator>;
+    using AllocatorTraits = erturk::allocator::AllocatorTraits<Allocator>;
 
 public:
     static constexpr size_t NPOS = -1;
@@ -82,125 +95,99 @@ public:
         CharT* char_ptr_;
     };
 
-    explicit BaseString() noexcept(false)
-        : capacity_{DEFAULT_CAPACITY_}, length_{0}, charBufferPtr_{Allocator::allocate(capacity_)}
-    {
-        if (charBufferPtr_ == nullptr)
-        {
-            throw std::runtime_error("Failed to allocate memory!");
-        }
+    // Empty string in the inline buffer, never allocates
+    explicit BaseString() noexcept : storage_{}, length_{0} {}
 
-        charBufferPtr_[size()] = '\0';  // null-terminator at index length_
-    }
+    explicit BaseString(const Allocator& allocator) noexcept : AllocatorHolder{allocator}, storage_{}, length_{0} {}
 
     // Instantiate from string literal
-    explicit BaseString(const char* c_string) noexcept(false) : capacity_{0}, length_{0}, charBufferPtr_{nullptr}
+    explicit BaseString(const char* c_string, const Allocator& allocator = Allocator{}) noexcept(false)
+        : AllocatorHolder{allocator}, storage_{}, length_{0}
     {
         if (c_string != nullptr)
         {
             // Num of string literal chars, excluding the null-terminator.
-            size_t literal_len = std::strlen(c_string);
-
-            length_ = literal_len;
-
-            capacity_ = size() + TERMINATOR_;
-
-            charBufferPtr_ = Allocator::allocate(capacity_);
-
-            if (charBufferPtr_ == nullptr)
-            {
-                throw std::runtime_error("Failed to allocate memory!");
-            }
-
-            erturk::memory::memcpy(c_string, data(), size());
-
-            charBufferPtr_[size()] = '\0';  // null-terminator at index length
+            assign_chars(c_string, std::strlen(c_string));
         }
     }
 
-    BaseString(const BaseString& other) noexcept(false)
-        : capacity_{other.capacity()}, length_{other.size()}, charBufferPtr_{Allocator::allocate(capacity_)}
+    // Instantiate from the first count chars of source
+    BaseString(const CharT* source, const size_t count, const Allocator& allocator = Allocator{}) noexcept(false)
+        : AllocatorHolder{allocator}, storage_{}, length_{0}
     {
-        if (charBufferPtr_ == nullptr)
-        {
-            throw std::runtime_error("Failed to allocate memory!");
-        }
-
-        // src_base, src_end, target_base
-        erturk::memory::memcpy<CharT>(other.data(), other.data() + other.size(), data());
-
-        charBufferPtr_[size()] = '\0';  // null-terminator at index length_
+        assign_chars(source, count);
     }
 
-    // Take over ownership
-    BaseString(BaseString&& other) noexcept(false)
-        : capacity_{other.capacity()}, length_{other.size()}, charBufferPtr_{Allocator::allocate(capacity_)}
+    explicit BaseString(const BasicStringView<CharT> view, const Allocator& allocator = Allocator{}) noexcept(false)
+        : AllocatorHolder{allocator}, storage_{}, length_{0}
     {
-        if (charBufferPtr_ == nullptr)
-        {
-            throw std::runtime_error("Failed to allocate memory!");
-        }
-
-        // src_base, src_end, target_base
-        erturk::memory::memcpy<CharT>(other.data(), other.data() + other.size(), data());
+        assign_chars(view.data(), view.size());
+    }
 
-        charBufferPtr_[size()] = '\0';  // null-terminator at index length_
+    BaseString(const BaseString& other) noexcept(false)
+        : AllocatorHolder{AllocatorTraits::select_on_copy_construction(other.get_allocator())}, storage_{}, length_{0}
+    {
+        assign_chars(other.data(), other.size());
+    }
 
-        other.clear();
+    // Take over ownership: steals the heap buffer (and a copy of the allocator) or copies the inline bytes, other is
+    // left empty
+    BaseString(BaseString&& other) noexcept
+        : AllocatorHolder{other.get_allocator()}, storage_{other.storage_}, length_{other.length_}
+    {
+        other.reset();
     }
 
     ~BaseString()
     {
-        clear();
-        Allocator::deallocate(data());
-        charBufferPtr_ = nullptr;
+        release();
     }
 
     BaseString& operator=(const BaseString& other) noexcept(false)
     {
         if (this != &other)
         {
-            clear();
-
-            size_t required_size = other.size() + TERMINATOR_;
-
-            if (required_size >= capacity())
+            if constexpr (AllocatorTraits::propagate_on_copy_assignment)
             {
-                expand_allocation(required_size);
+                // the buffer must go back to the allocator it came from
+                if (!AllocatorTraits::equal(this->allocator_instance(), other.get_allocator()))
+                {
+                    release();
+                    reset();
+                }
+                this->allocator_instance() = other.get_allocator();
             }
-
-            length_ = other.size();
-
-            // src_base, src_end, target_base
-            erturk::memory::memcpy<CharT>(other.data(), other.data() + other.size(), data());
-
-            charBufferPtr_[size()] = '\0';  // null-terminator at index length_
+            assign_chars(other.data(), other.size());
         }
         return *this;
     }
 
-    // Take over ownership
-    BaseString& operator=(BaseString&& other) noexcept
+    // Take over ownership, the chars are copied when the allocators differ and do not propagate
+    BaseString& operator=(BaseString&& other) noexcept(AllocatorTraits::propagate_on_move_assignment ||
+                                                       AllocatorTraits::is_always_equal)
     {
         if (this != &other)
         {
-            clear();
-
-            size_t required_size = other.size() + TERMINATOR_;
-
-            if (required_size >= capacity())
+            if constexpr (!AllocatorTraits::propagate_on_move_assignment && !AllocatorTraits::is_always_equal)
             {
-                expand_allocation(required_size);
+                if (!AllocatorTraits::equal(this->allocator_instance(), other.get_allocator()))
+                {
+                    assign_chars(other.data(), other.size());
+                    return *this;
+                }
             }
 
-            length_ = other.size();
+            release();
 
-            // src_base, src_end, target_base
-            erturk::memory::memcpy<CharT>(other.data(), other.data() + other.size(), data());
+            if constexpr (AllocatorTraits::propagate_on_move_assignment)
+            {
+                this->allocator_instance() = std::move(other.allocator_instance());
+            }
 
-            charBufferPtr_[size()] = '\0';  // null-terminator at index length_
+            storage_ = other.storage_;
+            length_ = other.length_;
 
-            other.clear();
+            other.reset();
         }
         return *this;
     }
@@ -212,84 +199,72 @@ public:
             throw std::runtime_error("Cannot assign null string literal!");
         }
 
-        clear();
+        assign_chars(c_string, std::strlen(c_string));
 
-        size_t literal_len = std::strlen(c_string);
-
-        size_t required_size = literal_len + TERMINATOR_;
+        return *this;
+    }
 
-        if (required_size >= capacity())
+    // Allocators are swapped when they propagate on swap, otherwise they must be equal
+    void swap(BaseString& other) noexcept
+    {
+        if constexpr (AllocatorTraits::propagate_on_swap)
         {
-            expand_allocation(required_size);
+            std::swap(this->allocator_instance(), other.allocator_instance());
         }
+        std::swap(storage_, other.storage_);
+        std::swap(length_, other.length_);
+    }
 
-        length_ = literal_len;
-
-        erturk::memory::memcpy_n<CharT>(c_string, size(), data());
-
-        charBufferPtr_[size()] = '\0';  // null-terminator at index length_
-
-        return *this;
+    [[nodiscard]] Allocator get_allocator() const noexcept
+    {
+        return this->allocator_instance();
     }
 
     void push_back(const CharT& ch)
     {
-        size_t required_capacity = size() + TERMINATOR_;
+        // room for ch and the null-terminator
+        ensure_capacity(size() + 1 + TERMINATOR_);
 
-        if (required_capacity >= capacity())
-        {
-            expand_allocation(required_capacity);
-        }
+        CharT* buffer = data();
+        const size_t length = size();
 
-        charBufferPtr_[size()] = ch;  // override null-terminator with value
+        buffer[length] = ch;  // override null-terminator with value
+        buffer[length + 1] = '\0';
 
-        length_++;
-
-        charBufferPtr_[size()] = '\0';  // add null-terminator at index length_
+        set_size(length + 1);
     }
 
     [[nodiscard]] CharT pop_back()
     {
-        CharT ch = charBufferPtr_[size() - TERMINATOR_];  // get char before null-terminator
+        CharT* buffer = data();
+        const size_t last = size() - 1;
+
+        CharT ch = buffer[last];  // get char before null-terminator
 
-        charBufferPtr_[size() - TERMINATOR_] = '\0';  // add null-terminator at index length_ - 1
+        buffer[last] = '\0';  // add null-terminator at index length_ - 1
 
-        length_--;
+        set_size(last);
 
         return ch;
     }
 
     void append(const CharT& ch)
     {
-        size_t required_capacity = size() + TERMINATOR_;
-
-        if (required_capacity >= capacity())
-        {
-            expand_allocation(required_capacity);
-        }
-
-        charBufferPtr_[size()] = ch;  // override null-terminator with ch
-
-        length_++;
-
-        charBufferPtr_[size()] = '\0';  // null-terminator at index length_
+        push_back(ch);
     }
 
     void append(const BaseString& other)
     {
-        size_t required_capacity = size() + other.size() + TERMINATOR_;
+        // other may be *this, its size is read before growing
+        const size_t other_size = other.size();
 
-        if (required_capacity >= capacity())
-        {
-            expand_allocation(required_capacity);
-        }
+        ensure_capacity(size() + other_size + TERMINATOR_);
 
-        // src_base, src_end, target_base
-        erturk::memory::memcpy<CharT>(other.data(), other.data() + other.size(), data() + size());
+        erturk::memory::memcpy_n<CharT>(other.data(), other_size, data() + size());
 
-        length_ += other.size();
+        set_size(size() + other_size);
 
-        charBufferPtr_[size()] = '\0';
+        data()[size()] = '\0';
     }
 
     void append(const char* c_string) noexcept(false)
@@ -301,26 +276,46 @@ public:
 
         size_t literal_len = std::strlen(c_string);
 
-        size_t required_capacity = literal_len + size() + TERMINATOR_;
+        ensure_capacity(size() + literal_len + TERMINATOR_);
 
-        if (required_capacity >= capacity())
-        {
-            expand_allocation(required_capacity);
-        }
+        erturk::memory::memcpy_n<CharT>(c_string, literal_len, data() + size());
 
-        // src_base, src_end, target_base
-        erturk::memory::memcpy<CharT>(c_string, c_string + literal_len, data() + size());
+        set_size(size() + literal_len);
 
-        length_ += literal_len;
-
-        charBufferPtr_[size()] = '\0';  // null-terminator at index size_
+        data()[size()] = '\0';  // null-terminator at index size_
     }
 
     void reserve(const size_t new_capacity)
     {
         if (new_capacity > capacity())
         {
-            expand_allocation(new_capacity);
+            reallocate_storage(new_capacity);
+        }
+    }
+
+    // Releases unused heap capacity, a string that fits the inline buffer moves back into it
+    void shrink_to_fit()
+    {
+        if (is_local())
+        {
+            return;
+        }
+
+        const size_t length = size();
+        const size_t required_capacity = length + TERMINATOR_;
+
+        if (required_capacity <= LOCAL_CAPACITY_)
+        {
+            const HeapBuffer heap = storage_.heap_;  // overlaid by the inline buffer
+
+            erturk::memory::memcpy_n<CharT>(heap.ptr_, required_capacity, storage_.local_);
+            this->allocator_instance().deallocate(heap.ptr_, heap.capacity_);
+
+            length_ = length;
+        }
+        else if (required_capacity < storage_.heap_.capacity_)
+        {
+            reallocate_storage(required_capacity);
         }
     }
 
@@ -330,7 +325,7 @@ public:
         {
             throw std::out_of_range("String is empty");
         }
-        return charBufferPtr_[0];
+        return data()[0];
     }
 
     [[nodiscard]] const CharT& back() const
@@ -339,314 +334,334 @@ public:
         {
             throw std::out_of_range("String is empty");
         }
-        return charBufferPtr_[size() - TERMINATOR_];
+        return data()[size() - 1];
     }
 
     [[nodiscard]] CharT& operator[](const size_t index) noexcept(false)
     {
-        if (index > size() - TERMINATOR_)
+        if (index >= size())
         {
             throw std::runtime_error("Out of bounds index!");
         }
-        return charBufferPtr_[index];
+        return data()[index];
     }
 
     [[nodiscard]] const CharT& operator[](const size_t index) const noexcept(false)
     {
-        if (index > size() - TERMINATOR_)
+        if (index >= size())
         {
             throw std::runtime_error("Out of bounds index!");
         }
-        return charBufferPtr_[index];
+        return data()[index];
     }
 
     [[nodiscard]] CharT& at(const size_t index) noexcept(false)
     {
-        if (index > size() - TERMINATOR_)
+        if (index >= size())
         {
             throw std::runtime_error("Out of bounds index!");
         }
-        return charBufferPtr_[index];
+        return data()[index];
     }
 
     [[nodiscard]] const CharT& at(const size_t index) const noexcept(false)
     {
-        if (index > size() - TERMINATOR_)
+        if (index >= size())
         {
             throw std::runtime_error("Out of bounds index!");
         }
-        return charBufferPtr_[index];
+        return data()[index];
     }
 
     [[nodiscard]] const CharT* c_str() const
     {
-        return charBufferPtr_ != nullptr ? charBufferPtr_ : "";
+        return data();
     }
 
     [[nodiscard]] CharT* data() const
     {
-        return charBufferPtr_;
+        return is_local() ? const_cast<CharT*>(storage_.local_) : storage_.heap_.ptr_;
     }
 
     [[nodiscard]] CharT* data()
     {
-        return charBufferPtr_;
+        return is_local() ? storage_.local_ : storage_.heap_.ptr_;
     }
 
     [[nodiscard]] size_t size() const
     {
-        return length_;
+        return length_ & ~HEAP_FLAG_;
     }
 
+    // length of buffer with terminator
     [[nodiscard]] size_t capacity() const
     {
-        return capacity_;
+        return is_local() ? LOCAL_CAPACITY_ : storage_.heap_.capacity_;
     }
 
+    // Keeps the buffer, like std::string
     void clear() noexcept
     {
-        if (charBufferPtr_ != nullptr)
-        {
-            erturk::memory::memset_n(data(), size(), '\0');
-        }
+        data()[0] = '\0';
+        set_size(0);
+    }
 
-        length_ = 0;
+    // Free conversion, the view is valid until the string is modified or destroyed
+    [[nodiscard]] operator BasicStringView<CharT>() const noexcept
+    {
+        return BasicStringView<CharT>{data(), size()};
+    }
+
+    [[nodiscard]] BasicStringView<CharT> view() const noexcept
+    {
+        return BasicStringView<CharT>{data(), size()};
     }
 
     [[nodiscard]] BaseString substr(size_t start_idx, size_t length) const noexcept(false)
     {
-        if (start_idx >= size() - TERMINATOR_)
+        if (start_idx > size())
         {
             throw std::out_of_range("Starting position is out of bounds");
         }
 
-        if (start_idx + length > size())
+        if (length > size() - start_idx)
         {
             length = size() - start_idx;  // Shrink length
         }
 
-        BaseString result{};
+        return BaseString{data() + start_idx, length, AllocatorTraits::select_on_copy_construction(get_allocator())};
+    }
 
-        size_t idx = 0;
-        while (idx < length)
-        {
-            result.push_back(charBufferPtr_[start_idx + idx]);
-            idx++;
-        }
+    // Substring search runs on the vectorized search engine, see memory/VectorizedSearch.hpp
+    [[nodiscard]] size_t find_first(const BaseString& from_str, const size_t index = 0) const
+    {
+        return find_pattern(from_str.data(), from_str.size(), index);
+    }
 
-        return result;
+    [[nodiscard]] size_t find_first(const char* from_c_string, const size_t index = 0) const
+    {
+        return find_pattern(from_c_string, std::strlen(from_c_string), index);
     }
 
-    [[nodiscard]] size_t find_first(const BaseString& from_str, const size_t index = 0) const
+    [[nodiscard]] size_t find_first(const CharT ch, const size_t index = 0) const
     {
-        if (from_str.size() == 0 || index >= size())
+        if (index >= size())
         {
             return BaseString::NPOS;
         }
 
-        if (from_str.size() == 0 && from_str.size() > size())
-        {
-            return BaseString::NPOS;
-        }
+        const CharT* found = erturk::memory::vectorized::find_n(data() + index, size() - index, ch);
 
-        Window window{};
+        return found != nullptr ? static_cast<size_t>(found - data()) : BaseString::NPOS;
+    }
 
-        window.baseIndex_ = index;
-        window.endIndex_ = index;
+    [[nodiscard]] bool contains(const BaseString& str) const
+    {
+        return find_first(str) != BaseString::NPOS;
+    }
 
-        size_t patternSize = from_str.size();
+    [[nodiscard]] bool contains(const char* c_string) const
+    {
+        return find_first(c_string) != BaseString::NPOS;
+    }
 
-        while (window.endIndex_ < size())
-        {
-            // Expand window to size of pattern
-            if ((window.endIndex_ - window.baseIndex_ + 1) != patternSize)
-            {
-                window.endIndex_++;
-                continue;
-            }
+    [[nodiscard]] bool contains(CharT ch) const
+    {
+        return find_first(ch) != BaseString::NPOS;
+    }
 
-            bool matchFound = true;
+    // base pointer
+    [[nodiscard]] Iterator begin()
+    {
+        return Iterator{data()};
+    }
 
-            // Match a current window with the pattern
-            size_t idx = 0;
-            while (idx < patternSize)
-            {
-                if (from_str.operator[](idx) == operator[](idx + window.baseIndex_))
-                {
-                    idx++;
-                    continue;
-                }
-                matchFound = false;
-                break;
-            }
+    // end pointer
+    [[nodiscard]] Iterator end()
+    {
+        return Iterator{data() + size()};
+    }
 
-            if (!matchFound)
-            {
-                // Move window forward by one
-                window.baseIndex_++;
+    // base pointer
+    [[nodiscard]] Iterator begin() const
+    {
+        return Iterator{data()};
+    }
 
-                // Shrink window to base
-                window.endIndex_ = window.baseIndex_;
-                continue;
-            }
-            return window.baseIndex_;  // return base index of matched pattern
-        }
-        return BaseString::NPOS;
+    // end pointer
+    [[nodiscard]] Iterator end() const
+    {
+        return Iterator{data() + size()};
     }
 
-    [[nodiscard]] size_t find_first(const char* from_c_string, const size_t index = 0) const
+private:
+    // Empty patterns are not found
+    template <typename PatternT>
+    [[nodiscard]] size_t find_pattern(const PatternT* pattern, const size_t pattern_size, const size_t index) const
     {
-        if (index >= size())
+        if (pattern_size == 0 || index >= size() || pattern_size > size() - index)
         {
             return BaseString::NPOS;
         }
 
-        size_t literal_len = std::strlen(from_c_string);
+        const CharT* buffer = data();
 
-        if (literal_len == 0 && literal_len > size())
+        if constexpr (sizeof(PatternT) == sizeof(CharT))
         {
-            return BaseString::NPOS;
-        }
-
-        Window window{};
+            const CharT* found = erturk::memory::vectorized::search_n(
+                buffer + index, size() - index, reinterpret_cast<const CharT*>(pattern), pattern_size);
 
-        size_t patternSize = literal_len;
-
-        window.baseIndex_ = index;
-        window.endIndex_ = index;
-
-        while (window.endIndex_ < size())
+            return found != nullptr ? static_cast<size_t>(found - buffer) : BaseString::NPOS;
+        }
+        else
         {
-            // Expand window to size of pattern
-            if ((window.endIndex_ - window.baseIndex_ + 1) != patternSize)
+            // char literal against a wide string, compare char by char
+            for (size_t base = index; base + pattern_size <= size(); base++)
             {
-                window.endIndex_++;
-                continue;
-            }
-
-            bool matchFound = true;
-
-            // Match a current window with the pattern
-            size_t idx = 0;
-            while (idx < patternSize)
-            {
-                if (from_c_string[idx] == operator[](idx + window.baseIndex_))
+                size_t idx = 0;
+                while (idx < pattern_size && buffer[base + idx] == static_cast<CharT>(pattern[idx]))
                 {
                     idx++;
-                    continue;
                 }
-                matchFound = false;
-                break;
-            }
-
-            if (!matchFound)
-            {
-                // Move window forward by one
-                window.baseIndex_++;
-
-                // Shrink window to base
-                window.endIndex_ = window.baseIndex_;
-                continue;
+                if (idx == pattern_size)
+                {
+                    return base;
+                }
             }
-            return window.baseIndex_;  // return base index of the matched pattern
+            return BaseString::NPOS;
         }
-        return BaseString::NPOS;
     }
 
-    [[nodiscard]] size_t find_first(const CharT ch, const size_t index = 0) const
+    struct HeapBuffer
     {
-        if (index > size() - TERMINATOR_)
-        {
-            return BaseString::NPOS;
-        }
-
-        size_t idx = index;
+        CharT* ptr_;
+        size_t capacity_;  // length of buffer with terminator
+    };
 
-        while (idx < size())
-        {
-            if (charBufferPtr_[idx] == ch)
-            {
-                return idx;
-            }
-            idx++;
-        }
+    // local_ first, so value initialization zeroes the inline buffer
+    union Storage
+    {
+        CharT local_[LOCAL_CAPACITY_];
+        HeapBuffer heap_;
+    };
 
-        return BaseString::NPOS;
+    [[nodiscard]] bool is_local() const noexcept
+    {
+        return (length_ & HEAP_FLAG_) == 0;
     }
 
-    [[nodiscard]] bool contains(const BaseString& str) const
+    void set_size(const size_t length) noexcept
     {
-        return find_first(str) != BaseString::NPOS;
+        length_ = (length_ & HEAP_FLAG_) | length;
     }
 
-    [[nodiscard]] bool contains(const char* c_string) const
+    CharT* allocate_buffer(const size_t capacity) noexcept(false)
     {
-        return find_first(c_string) != BaseString::NPOS;
+        CharT* buffer = this->allocator_instance().allocate(capacity);
+
+        if (buffer == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate memory!");
+        }
+        return buffer;
     }
 
-    [[nodiscard]] bool contains(CharT ch) const
+    void release() noexcept
     {
-        return find_first(ch) != BaseString::NPOS;
+        if (!is_local())
+        {
+            this->allocator_instance().deallocate(storage_.heap_.ptr_, storage_.heap_.capacity_);
+        }
     }
 
-    // base pointer
-    [[nodiscard]] Iterator begin()
+    // Back to an empty inline string, the heap buffer (if any) must be released or taken over already
+    void reset() noexcept
     {
-        return Iterator{charBufferPtr_};
+        length_ = 0;
+        storage_.local_[0] = '\0';
     }
 
-    // end pointer
-    [[nodiscard]] Iterator end()
+    void ensure_capacity(const size_t required_capacity) noexcept(false)
     {
-        return Iterator{charBufferPtr_ + size()};
+        if (required_capacity > capacity())
+        {
+            expand_allocation(required_capacity);
+        }
     }
 
-    // base pointer
-    [[nodiscard]] Iterator begin() const
+    // Replaces the content, source may point into the current buffer
+    void assign_chars(const CharT* source, const size_t count) noexcept(false)
     {
-        return Iterator{data()};
+        if (count + TERMINATOR_ <= capacity())
+        {
+            CharT* buffer = data();
+            if (count != 0)
+            {
+                std::memmove(buffer, source, count * sizeof(CharT));
+            }
+            buffer[count] = '\0';
+            set_size(count);
+            return;
+        }
+
+        const size_t new_capacity = count + TERMINATOR_;
+        CharT* new_buffer = allocate_buffer(new_capacity);
+
+        erturk::memory::memcpy_n<CharT>(source, count, new_buffer);
+        new_buffer[count] = '\0';
+
+        release();
+
+        storage_.heap_ = HeapBuffer{new_buffer, new_capacity};
+        length_ = HEAP_FLAG_ | count;
     }
 
-    // end pointer
-    [[nodiscard]] Iterator end() const
+    void expand_allocation(const size_t required_capacity) noexcept(false)
     {
-        return Iterator{data() + size()};
+        reallocate_storage(Growth::next_capacity(capacity(), required_capacity));
     }
 
-private:
-    void expand_allocation(size_t new_capacity, size_t times = DEFAULT_MULTIPLICATION) noexcept(false)
+    // Moves the content into a heap buffer of new_capacity (with terminator), an existing heap buffer is resized
+    void reallocate_storage(const size_t new_capacity) noexcept(false)
     {
-        CharT* new_buffer = Allocator::allocate(new_capacity * times);
-
-        if (charBufferPtr_ == nullptr)
+        if (is_local())
         {
-            throw std::runtime_error("Failed to allocate memory!");
-        }
+            CharT* new_buffer = allocate_buffer(new_capacity);
 
-        // src_base, src_end, target_base
-        erturk::memory::memcpy<CharT>(data(), data() + size(), new_buffer);
+            // content and null-terminator
+            erturk::memory::memcpy_n<CharT>(storage_.local_, size() + TERMINATOR_, new_buffer);
 
-        Allocator::deallocate(data());
+            storage_.heap_ = HeapBuffer{new_buffer, new_capacity};
+            length_ |= HEAP_FLAG_;
+            return;
+        }
 
-        charBufferPtr_ = new_buffer;
-        capacity_ = new_capacity;
+        storage_.heap_.ptr_ = growth::relocate_buffer<CharT, Allocator>(this->allocator_instance(), storage_.heap_.ptr_,
+                                                                        size() + TERMINATOR_, storage_.heap_.capacity_,
+                                                                        new_capacity);
+        storage_.heap_.capacity_ = new_capacity;
     }
 
 private:
-    size_t capacity_{0};  // length of buffer with terminator
-    size_t length_{0};    // length of the char array without terminator
-    CharT* charBufferPtr_{nullptr};
-
-private:
-    struct Window
-    {
-        size_t baseIndex_{0};
-        size_t endIndex_{0};
-    };
+    Storage storage_;
+    size_t length_{0};  // length of the char array without terminator, HEAP_FLAG_ set for heap storage
 };
 
 using String = BaseString<char>;
 
 }  // namespace erturk::container
 
+namespace erturk::meta
+{
+
+// Neither the inline buffer nor the heap buffer is referenced by address, a byte copy is a valid move when it is one
+// for the allocator
+template <typename CharT, typename Allocator, typename Growth>
+struct is_trivially_relocatable<erturk::container::BaseString<CharT, Allocator, Growth>>
+    : is_trivially_relocatable<Allocator>
+{
+};
+
+}  // namespace erturk::meta
+
 #endif  // ERTURK_STRING_H
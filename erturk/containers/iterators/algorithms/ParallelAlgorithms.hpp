@@ -0,0 +1,583 @@
+#ifndef ERTURK_PARALLEL_ALGORITHMS_H
+#define ERTURK_PARALLEL_ALGORITHMS_H
+
+#include "../../../concurrency/execution/Executor.hpp"
+#include "../../../vectorization/SimdDispatch.hpp"
+#include "../../../vectorization/SimdReduce.hpp"
+#include "../../../vectorization/SimdSort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Parallel bulk algorithms over contiguous ranges: Array, DynamicTypeBufferArray, std::span (anything with data() and
+size()).
+
+  erturk::container::parallel::sort(array);                       // default_executor()
+  erturk::container::parallel::reduce(executor, values, 0.0f);    // any erturk::concurrency::execution::Executor
+
+Grain size: a range is cut into chunks of at least MIN_GRAIN_BYTES_, at most CHUNKS_PER_THREAD_ chunks per thread of
+the executor (slack for work stealing when chunks take uneven time). Ranges smaller than one grain run inline on the
+calling thread, no task is created.
+
+Inner loops per chunk:
+- reduce / inclusive_scan (pass 1): float into float with std::plus uses simd::sumFloats (widest ISA of the running
+  CPU), other arithmetic types fold into ACCUMULATORS_ independent accumulators the compiler keeps in vector registers.
+  Chunks accumulate in the result type (reduce's init, inclusive_scan's output element), not the element type, so
+  bytes summed into a size_t do not wrap at 255.
+- transform: float with std::plus/minus/multiplies/divides uses the simd::*Floats kernels, other types a plain
+  indexed loop.
+- sort: chunks are sorted with simd::sortFloats (float, std::less) or std::sort, then merged pairwise in rounds.
+  Every merge is split by output position (merge path co-ranks), so all threads work until the last round.
+
+Like std::reduce, reduce and inclusive_scan need an associative operation, reduce also a commutative one (the order
+of folding is not left to right). sort is not stable and needs T default constructible and move assignable.
+*/
+namespace erturk::container::parallel
+{
+
+inline constexpr size_t MIN_GRAIN_BYTES_ = size_t{16} * 1024;  // smaller chunks cost more in tasks than they save
+inline constexpr size_t CHUNKS_PER_THREAD_ = 4;
+inline constexpr size_t ACCUMULATORS_ = 8;
+
+template <class R>
+concept ContiguousRange = requires(R& range) {
+    requires std::is_pointer_v<decltype(range.data())>;
+    {
+        range.size()
+    } -> std::convertible_to<size_t>;
+};
+
+template <ContiguousRange R>
+[[nodiscard]] inline auto as_span(R& range) noexcept
+{
+    using T = std::remove_pointer_t<decltype(range.data())>;
+    return std::span<T>{range.data(), static_cast<size_t>(range.size())};
+}
+
+namespace detail
+{
+
+struct Chunking
+{
+    size_t count_;
+    size_t width_;  // every chunk but the last one
+
+    [[nodiscard]] size_t first(const size_t chunk) const noexcept
+    {
+        return chunk * width_;
+    }
+
+    [[nodiscard]] size_t last(const size_t chunk, const size_t size) const noexcept
+    {
+        return std::min(size, (chunk + 1) * width_);
+    }
+};
+
+[[nodiscard]] inline Chunking make_chunking(const size_t size, const size_t element_size,
+                                            const size_t concurrency) noexcept
+{
+    const size_t min_grain = std::max<size_t>(1, MIN_GRAIN_BYTES_ / std::max<size_t>(1, element_size));
+
+    if (size <= min_grain || concurrency <= 1)
+    {
+        return Chunking{1, std::max<size_t>(1, size)};
+    }
+
+    const size_t count = std::min((size + min_grain - 1) / min_grain, concurrency * CHUNKS_PER_THREAD_);
+    const size_t width = (size + count - 1) / count;
+    return Chunking{(size + width - 1) / width, width};
+}
+
+template <class Op, class T>
+inline constexpr bool is_plus_ = std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>;
+
+template <class Op, class T>
+inline constexpr bool is_less_ = std::is_same_v<Op, std::less<>> || std::is_same_v<Op, std::less<T>>;
+
+// Fold of data[0, size) accumulated in T, size >= 1
+template <class T, class V, class Op>
+[[nodiscard]] inline T reduce_chunk(const V* data, const size_t size, Op& op)
+{
+    if constexpr (std::is_same_v<T, float> && std::is_same_v<V, float> && is_plus_<Op, T>)
+    {
+        return erturk::simd::sumFloats(data, size);
+    }
+    else if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<V>)
+    {
+        if (size >= 2 * ACCUMULATORS_)
+        {
+            T accumulators[ACCUMULATORS_];
+            for (size_t lane = 0; lane < ACCUMULATORS_; lane++)
+            {
+                accumulators[lane] = static_cast<T>(data[lane]);
+            }
+
+            size_t idx = ACCUMULATORS_;
+            for (; idx + ACCUMULATORS_ <= size; idx += ACCUMULATORS_)
+            {
+                for (size_t lane = 0; lane < ACCUMULATORS_; lane++)
+                {
+                    accumulators[lane] = op(accumulators[lane], data[idx + lane]);
+                }
+            }
+
+            T result = accumulators[0];
+            for (size_t lane = 1; lane < ACCUMULATORS_; lane++)
+            {
+                result = op(result, accumulators[lane]);
+            }
+            for (; idx < size; idx++)
+            {
+                result = op(result, data[idx]);
+            }
+            return result;
+        }
+    }
+
+    T result = static_cast<T>(data[0]);
+    for (size_t idx = 1; idx < size; idx++)
+    {
+        result = op(std::move(result), data[idx]);
+    }
+    return result;
+}
+
+template <class T, class Compare>
+inline void sort_chunk(T* data, const size_t size, Compare& comp)
+{
+    if constexpr (std::is_same_v<T, float> && is_less_<Compare, T>)
+    {
+        erturk::simd::sortFloats(data, size);
+    }
+    else
+    {
+        std::sort(data, data + size, comp);
+    }
+}
+
+// Elements of a among the first diagonal elements of the stable merge of a and b
+template <class T, class Compare>
+[[nodiscard]] inline size_t co_rank(const size_t diagonal, const T* a, const size_t a_size, const T* b,
+                                    const size_t b_size, Compare& comp)
+{
+    size_t low = diagonal > b_size ? diagonal - b_size : 0;
+    size_t high = std::min(diagonal, a_size);
+
+    while (low < high)
+    {
+        const size_t i = low + (high - low) / 2;
+        const size_t j = diagonal - i;
+
+        // the merge takes a[i] before b[j - 1] (ties go to a): a[i] is among the first diagonal elements
+        if (!comp(b[j - 1], a[i]))
+        {
+            low = i + 1;
+        }
+        else
+        {
+            high = i;
+        }
+    }
+    return low;
+}
+
+template <class E, class T, class Compare>
+inline void merge_runs(const E& executor, T* source, T* target, const size_t size, const size_t run_width,
+                       const size_t piece_count, Compare& comp)
+{
+    const size_t pair_width = 2 * run_width;
+    const size_t pair_count = (size + pair_width - 1) / pair_width;
+    const size_t piece_width = std::max<size_t>(1, (size + piece_count - 1) / piece_count);
+    const size_t pieces_per_pair = (pair_width + piece_width - 1) / piece_width;
+
+    struct Pair
+    {
+        size_t first_;
+        size_t a_size_;
+        size_t b_size_;
+    };
+
+    const auto pair_at = [&](const size_t pair) noexcept
+    {
+        const size_t first = pair * pair_width;
+        const size_t middle = std::min(size, first + run_width);
+        return Pair{first, middle - first, std::min(size, first + pair_width) - middle};
+    };
+
+    // split points first: merging moves elements out that a neighbour's co-rank search would still compare
+    std::vector<size_t> splits(pair_count * pieces_per_pair);
+    executor.bulk(pair_count,
+                  [&](const size_t pair)
+                  {
+                      const Pair runs = pair_at(pair);
+                      const T* a = source + runs.first_;
+
+                      for (size_t piece = 0; piece < pieces_per_pair; piece++)
+                      {
+                          const size_t diagonal = std::min(piece * piece_width, runs.a_size_ + runs.b_size_);
+                          splits[pair * pieces_per_pair + piece] =
+                              co_rank(diagonal, a, runs.a_size_, a + runs.a_size_, runs.b_size_, comp);
+                      }
+                  });
+
+    executor.bulk(pair_count * pieces_per_pair,
+                  [&](const size_t item)
+                  {
+                      const size_t pair = item / pieces_per_pair;
+                      const size_t piece = item % pieces_per_pair;
+                      const Pair runs = pair_at(pair);
+                      const size_t total = runs.a_size_ + runs.b_size_;
+
+                      const size_t first_diagonal = std::min(piece * piece_width, total);
+                      const size_t last_diagonal = std::min((piece + 1) * piece_width, total);
+                      if (first_diagonal == last_diagonal)
+                      {
+                          return;
+                      }
+
+                      const size_t a_first = splits[item];
+                      const size_t a_last = piece + 1 < pieces_per_pair ? splits[item + 1] : runs.a_size_;
+                      T* a = source + runs.first_;
+                      T* b = a + runs.a_size_;
+
+                      std::merge(std::make_move_iterator(a + a_first), std::make_move_iterator(a + a_last),
+                                 std::make_move_iterator(b + (first_diagonal - a_first)),
+                                 std::make_move_iterator(b + (last_diagonal - a_last)),
+                                 target + runs.first_ + first_diagonal, comp);
+                  });
+}
+
+}  // namespace detail
+
+/**
+ *  @brief  Calls function(T&) for every element.
+ */
+template <class E, ContiguousRange R, class Function>
+    requires erturk::concurrency::execution::Executor<E>
+inline void for_each(const E& executor, R&& range, Function function)
+{
+    const auto values = as_span(range);
+    const detail::Chunking chunking =
+        detail::make_chunking(values.size(), sizeof(values[0]), executor.concurrency());
+
+    const auto run = [&](const size_t chunk)
+    {
+        const size_t last = chunking.last(chunk, values.size());
+        for (size_t idx = chunking.first(chunk); idx < last; idx++)
+        {
+            function(values[idx]);
+        }
+    };
+
+    if (chunking.count_ == 1)
+    {
+        run(0);
+        return;
+    }
+    executor.bulk(chunking.count_, run);
+}
+
+/**
+ *  @brief  output[i] = function(input[i]), output may be input.
+ */
+template <class E, ContiguousRange In, ContiguousRange Out, class Function>
+    requires erturk::concurrency::execution::Executor<E>
+inline void transform(const E& executor, In&& input, Out&& output, Function function) noexcept(false)
+{
+    const auto source = as_span(input);
+    const auto target = as_span(output);
+
+    if (target.size() < source.size())
+    {
+        throw std::runtime_error("Output range is too small!");
+    }
+
+    const detail::Chunking chunking =
+        detail::make_chunking(source.size(), sizeof(source[0]), executor.concurrency());
+
+    const auto run = [&](const size_t chunk)
+    {
+        const size_t last = chunking.last(chunk, source.size());
+        for (size_t idx = chunking.first(chunk); idx < last; idx++)
+        {
+            target[idx] = function(source[idx]);
+        }
+    };
+
+    if (chunking.count_ == 1)
+    {
+        run(0);
+        return;
+    }
+    executor.bulk(chunking.count_, run);
+}
+
+/**
+ *  @brief  output[i] = function(lhs[i], rhs[i]), output may be lhs or rhs.
+ */
+template <class E, ContiguousRange Lhs, ContiguousRange Rhs, ContiguousRange Out, class Function>
+    requires erturk::concurrency::execution::Executor<E>
+inline void transform(const E& executor, Lhs&& lhs, Rhs&& rhs, Out&& output, Function function) noexcept(false)
+{
+    const auto left = as_span(lhs);
+    const auto right = as_span(rhs);
+    const auto target = as_span(output);
+
+    if (right.size() < left.size() || target.size() < left.size())
+    {
+        throw std::runtime_error("Input or output range is too small!");
+    }
+
+    using L = std::remove_cv_t<typename decltype(left)::element_type>;
+    using R = std::remove_cv_t<typename decltype(right)::element_type>;
+    using O = typename decltype(target)::element_type;
+    constexpr bool FLOAT_KERNEL = std::is_same_v<L, float> && std::is_same_v<R, float> && std::is_same_v<O, float>;
+
+    const detail::Chunking chunking = detail::make_chunking(left.size(), sizeof(left[0]), executor.concurrency());
+
+    const auto run = [&](const size_t chunk)
+    {
+        const size_t first = chunking.first(chunk);
+        const size_t last = chunking.last(chunk, left.size());
+
+        if constexpr (FLOAT_KERNEL &&
+                      (std::is_same_v<Function, std::plus<>> || std::is_same_v<Function, std::plus<float>>))
+        {
+            erturk::simd::addFloats(left.data() + first, right.data() + first, target.data() + first, last - first);
+        }
+        else if constexpr (FLOAT_KERNEL &&
+                           (std::is_same_v<Function, std::minus<>> || std::is_same_v<Function, std::minus<float>>))
+        {
+            erturk::simd::subtractFloats(left.data() + first, right.data() + first, target.data() + first,
+                                         last - first);
+        }
+        else if constexpr (FLOAT_KERNEL && (std::is_same_v<Function, std::multiplies<>> ||
+                                            std::is_same_v<Function, std::multiplies<float>>))
+        {
+            erturk::simd::multiplyFloats(left.data() + first, right.data() + first, target.data() + first,
+                                         last - first);
+        }
+        else if constexpr (FLOAT_KERNEL &&
+                           (std::is_same_v<Function, std::divides<>> || std::is_same_v<Function, std::divides<float>>))
+        {
+            erturk::simd::divideFloats(left.data() + first, right.data() + first, target.data() + first, last - first);
+        }
+        else
+        {
+            for (size_t idx = first; idx < last; idx++)
+            {
+                target[idx] = function(left[idx], right[idx]);
+            }
+        }
+    };
+
+    if (chunking.count_ == 1)
+    {
+        run(0);
+        return;
+    }
+    executor.bulk(chunking.count_, run);
+}
+
+/**
+ *  @brief  Folds init and every element with op (associative and commutative).
+ */
+template <class E, ContiguousRange R, class T, class Op = std::plus<>>
+    requires erturk::concurrency::execution::Executor<E>
+[[nodiscard]] inline T reduce(const E& executor, R&& range, T init, Op op = Op{})
+{
+    const auto values = as_span(range);
+    using V = std::remove_cv_t<typename decltype(values)::element_type>;
+
+    if (values.empty())
+    {
+        return init;
+    }
+
+    const detail::Chunking chunking = detail::make_chunking(values.size(), sizeof(V), executor.concurrency());
+
+    if (chunking.count_ == 1)
+    {
+        return op(std::move(init), detail::reduce_chunk<T>(values.data(), values.size(), op));
+    }
+
+    std::vector<std::optional<T>> partials(chunking.count_);
+    executor.bulk(chunking.count_,
+                  [&](const size_t chunk)
+                  {
+                      const size_t first = chunking.first(chunk);
+                      partials[chunk].emplace(detail::reduce_chunk<T>(
+                          values.data() + first, chunking.last(chunk, values.size()) - first, op));
+                  });
+
+    for (std::optional<T>& partial : partials)
+    {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+/**
+ *  @brief  output[i] = input[0] op ... op input[i] (op associative), output may be input.
+ *  The running totals are kept in the output's element type.
+ *
+ *  Two passes: chunk totals in parallel, their running totals on the calling thread, then every chunk is scanned
+ *  starting from the total of the chunks before it.
+ */
+template <class E, ContiguousRange In, ContiguousRange Out, class Op = std::plus<>>
+    requires erturk::concurrency::execution::Executor<E>
+inline void inclusive_scan(const E& executor, In&& input, Out&& output, Op op = Op{}) noexcept(false)
+{
+    const auto source = as_span(input);
+    const auto target = as_span(output);
+    using V = std::remove_cv_t<typename decltype(source)::element_type>;
+    using A = typename decltype(target)::element_type;
+
+    if (target.size() < source.size())
+    {
+        throw std::runtime_error("Output range is too small!");
+    }
+    if (source.empty())
+    {
+        return;
+    }
+
+    const detail::Chunking chunking = detail::make_chunking(source.size(), sizeof(V), executor.concurrency());
+
+    const auto scan = [&](const size_t chunk, std::optional<A>& carry)
+    {
+        const size_t first = chunking.first(chunk);
+        const size_t last = chunking.last(chunk, source.size());
+
+        A running = carry.has_value() ? op(std::move(*carry), source[first]) : static_cast<A>(source[first]);
+        target[first] = running;
+        for (size_t idx = first + 1; idx < last; idx++)
+        {
+            running = op(std::move(running), source[idx]);
+            target[idx] = running;
+        }
+    };
+
+    std::vector<std::optional<A>> carries(chunking.count_);
+
+    if (chunking.count_ == 1)
+    {
+        scan(0, carries[0]);
+        return;
+    }
+
+    // the last chunk's total is never needed
+    executor.bulk(chunking.count_ - 1,
+                  [&](const size_t chunk)
+                  {
+                      const size_t first = chunking.first(chunk);
+                      carries[chunk + 1].emplace(detail::reduce_chunk<A>(
+                          source.data() + first, chunking.last(chunk, source.size()) - first, op));
+                  });
+
+    // carries[chunk - 1] is still read by its own chunk's scan, copy it
+    for (size_t chunk = 2; chunk < chunking.count_; chunk++)
+    {
+        carries[chunk] = op(*carries[chunk - 1], std::move(*carries[chunk]));
+    }
+
+    executor.bulk(chunking.count_, [&](const size_t chunk) { scan(chunk, carries[chunk]); });
+}
+
+/**
+ *  @brief  Sorts the range by comp (not stable).
+ */
+template <class E, ContiguousRange R, class Compare = std::less<>>
+    requires erturk::concurrency::execution::Executor<E>
+inline void sort(const E& executor, R&& range, Compare comp = Compare{})
+{
+    const auto values = as_span(range);
+    using V = typename decltype(values)::element_type;
+
+    const size_t size = values.size();
+    const detail::Chunking chunking = detail::make_chunking(size, sizeof(V), executor.concurrency());
+
+    if (chunking.count_ == 1)
+    {
+        detail::sort_chunk(values.data(), size, comp);
+        return;
+    }
+
+    executor.bulk(chunking.count_,
+                  [&](const size_t chunk)
+                  {
+                      const size_t first = chunking.first(chunk);
+                      detail::sort_chunk(values.data() + first, chunking.last(chunk, size) - first, comp);
+                  });
+
+    std::unique_ptr<V[]> buffer = std::make_unique_for_overwrite<V[]>(size);
+    V* source = values.data();
+    V* target = buffer.get();
+
+    for (size_t run_width = chunking.width_; run_width < size; run_width *= 2)
+    {
+        detail::merge_runs(executor, source, target, size, run_width, chunking.count_, comp);
+        std::swap(source, target);
+    }
+
+    if (source != values.data())
+    {
+        executor.bulk(chunking.count_,
+                      [&](const size_t chunk)
+                      {
+                          std::move(source + chunking.first(chunk), source + chunking.last(chunk, size),
+                                    values.data() + chunking.first(chunk));
+                      });
+    }
+}
+
+// default_executor() overloads
+
+template <ContiguousRange R, class Function>
+inline void for_each(R&& range, Function function)
+{
+    parallel::for_each(erturk::concurrency::execution::default_executor(), range, std::move(function));
+}
+
+template <ContiguousRange In, ContiguousRange Out, class Function>
+inline void transform(In&& input, Out&& output, Function function) noexcept(false)
+{
+    parallel::transform(erturk::concurrency::execution::default_executor(), input, output, std::move(function));
+}
+
+template <ContiguousRange Lhs, ContiguousRange Rhs, ContiguousRange Out, class Function>
+inline void transform(Lhs&& lhs, Rhs&& rhs, Out&& output, Function function) noexcept(false)
+{
+    parallel::transform(erturk::concurrency::execution::default_executor(), lhs, rhs, output, std::move(function));
+}
+
+template <ContiguousRange R, class T, class Op = std::plus<>>
+[[nodiscard]] inline T reduce(R&& range, T init, Op op = Op{})
+{
+    return parallel::reduce(erturk::concurrency::execution::default_executor(), range, std::move(init), op);
+}
+
+template <ContiguousRange In, ContiguousRange Out, class Op = std::plus<>>
+inline void inclusive_scan(In&& input, Out&& output, Op op = Op{}) noexcept(false)
+{
+    parallel::inclusive_scan(erturk::concurrency::execution::default_executor(), input, output, op);
+}
+
+template <ContiguousRange R, class Compare = std::less<>>
+inline void sort(R&& range, Compare comp = Compare{})
+{
+    parallel::sort(erturk::concurrency::execution::default_executor(), range, comp);
+}
+
+}  // namespace erturk::container::parallel
+
+#endif  // ERTURK_PARALLEL_ALGORITHMS_H
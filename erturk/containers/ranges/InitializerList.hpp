@@ -15,7 +15,7 @@ public:
 
     size_t size() const
     {
-        return (endPtr_ - beginPtr_) / sizeof(T);
+        return endPtr_ - beginPtr_;
     }
 
     const T* begin() const
@@ -0,0 +1,403 @@
+#ifndef ERTURK_STRING_VIEW_H
+#define ERTURK_STRING_VIEW_H
+
+#include "../../memory/VectorizedSearch.hpp"
+#include <cstddef>
+#include <stdexcept>
+
+/*
+Non-owning view of a char sequence: a pointer and a length, no terminator is required.
+
+substr/trim/remove_prefix return or shrink views over the same memory, find runs on the vectorized search engine.
+split/tokenize return lazy ranges, each step finds the next delimiter and yields the field in between:
+- split    : keeps empty fields, "a,,b" -> "a", "", "b".
+- tokenize : skips empty fields, "a,,b" -> "a", "b".
+
+The viewed memory must outlive the view (and every range or iterator made from it).
+*/
+namespace erturk::container
+{
+
+template <typename CharT>
+class BasicStringView;
+
+template <typename CharT, typename Delimiter>
+class SplitRange
+{
+public:
+    class Iterator
+    {
+    public:
+        Iterator() = default;
+
+        Iterator(const BasicStringView<CharT> remaining, const Delimiter delimiter, const bool skip_empty)
+            : remaining_{remaining}, delimiter_{delimiter}, skip_empty_{skip_empty}, done_{false}
+        {
+            advance();
+        }
+
+        Iterator& operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            advance();
+            return temp;
+        }
+
+        [[nodiscard]] BasicStringView<CharT> operator*() const
+        {
+            return current_;
+        }
+
+        [[nodiscard]] const BasicStringView<CharT>* operator->() const
+        {
+            return &current_;
+        }
+
+        // Iterators of one range are equal when both are at the end or at the same field
+        [[nodiscard]] bool operator==(const Iterator& other) const
+        {
+            if (done_ || other.done_)
+            {
+                return done_ == other.done_;
+            }
+            return current_.data() == other.current_.data() && current_.size() == other.current_.size();
+        }
+
+    private:
+        void advance()
+        {
+            if (finished_)
+            {
+                done_ = true;
+                return;
+            }
+
+            do
+            {
+                const size_t delimiter_size = BasicStringView<CharT>::delimiter_size(delimiter_);
+                const size_t position =
+                    delimiter_size == 0 ? BasicStringView<CharT>::NPOS : remaining_.find(delimiter_);
+
+                if (position == BasicStringView<CharT>::NPOS)
+                {
+                    current_ = remaining_;
+                    finished_ = true;
+                }
+                else
+                {
+                    current_ = BasicStringView<CharT>{remaining_.data(), position};
+                    remaining_.remove_prefix(position + delimiter_size);
+                }
+            } while (skip_empty_ && current_.empty() && !finished_);
+
+            if (skip_empty_ && current_.empty())
+            {
+                done_ = true;
+            }
+        }
+
+    private:
+        BasicStringView<CharT> remaining_{};
+        BasicStringView<CharT> current_{};
+        Delimiter delimiter_{};
+        bool skip_empty_{false};
+        bool finished_{false};  // remaining_ has been handed out, the next step reaches the end
+        bool done_{true};
+    };
+
+    SplitRange(const BasicStringView<CharT> source, const Delimiter delimiter, const bool skip_empty)
+        : source_{source}, delimiter_{delimiter}, skip_empty_{skip_empty}
+    {
+    }
+
+    [[nodiscard]] Iterator begin() const
+    {
+        return Iterator{source_, delimiter_, skip_empty_};
+    }
+
+    [[nodiscard]] Iterator end() const
+    {
+        return Iterator{};
+    }
+
+private:
+    BasicStringView<CharT> source_;
+    Delimiter delimiter_;
+    bool skip_empty_;
+};
+
+template <typename CharT>
+class BasicStringView
+{
+public:
+    static constexpr size_t NPOS = -1;
+
+    using Iterator = const CharT*;
+
+public:
+    constexpr BasicStringView() noexcept = default;
+
+    constexpr BasicStringView(const CharT* data, const size_t size) noexcept : data_{data}, size_{size} {}
+
+    // Null-terminated string, the terminator is not part of the view
+    constexpr BasicStringView(const CharT* c_string) noexcept : data_{c_string}, size_{length(c_string)} {}
+
+    [[nodiscard]] constexpr const CharT* data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr const CharT& operator[](const size_t index) const noexcept
+    {
+        return data_[index];
+    }
+
+    [[nodiscard]] constexpr const CharT& at(const size_t index) const noexcept(false)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Out of bounds index!");
+        }
+        return data_[index];
+    }
+
+    [[nodiscard]] constexpr const CharT& front() const noexcept(false)
+    {
+        if (empty())
+        {
+            throw std::out_of_range("String view is empty");
+        }
+        return data_[0];
+    }
+
+    [[nodiscard]] constexpr const CharT& back() const noexcept(false)
+    {
+        if (empty())
+        {
+            throw std::out_of_range("String view is empty");
+        }
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] constexpr Iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] constexpr Iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    constexpr void remove_prefix(const size_t count) noexcept
+    {
+        const size_t removed = count < size_ ? count : size_;
+        data_ += removed;
+        size_ -= removed;
+    }
+
+    constexpr void remove_suffix(const size_t count) noexcept
+    {
+        size_ -= count < size_ ? count : size_;
+    }
+
+    // No copy, the result views the same memory
+    [[nodiscard]] constexpr BasicStringView substr(const size_t start_idx, size_t length = NPOS) const noexcept(false)
+    {
+        if (start_idx > size_)
+        {
+            throw std::out_of_range("Starting position is out of bounds");
+        }
+
+        if (length > size_ - start_idx)
+        {
+            length = size_ - start_idx;  // Shrink length
+        }
+
+        return BasicStringView{data_ + start_idx, length};
+    }
+
+    [[nodiscard]] size_t find(const CharT ch, const size_t index = 0) const noexcept
+    {
+        if (index >= size_)
+        {
+            return NPOS;
+        }
+
+        const CharT* found = erturk::memory::vectorized::find_n(data_ + index, size_ - index, ch);
+
+        return found != nullptr ? static_cast<size_t>(found - data_) : NPOS;
+    }
+
+    // An empty pattern is found at index
+    [[nodiscard]] size_t find(const BasicStringView pattern, const size_t index = 0) const noexcept
+    {
+        if (index > size_ || pattern.size() > size_ - index)
+        {
+            return NPOS;
+        }
+        if (pattern.size() == 0)
+        {
+            return index;  // handled here, search_n finds nothing in a null view
+        }
+
+        const CharT* found =
+            erturk::memory::vectorized::search_n(data_ + index, size_ - index, pattern.data(), pattern.size());
+
+        return found != nullptr ? static_cast<size_t>(found - data_) : NPOS;
+    }
+
+    [[nodiscard]] bool contains(const CharT ch) const noexcept
+    {
+        return find(ch) != NPOS;
+    }
+
+    [[nodiscard]] bool contains(const BasicStringView pattern) const noexcept
+    {
+        return find(pattern) != NPOS;
+    }
+
+    [[nodiscard]] constexpr bool starts_with(const CharT ch) const noexcept
+    {
+        return !empty() && data_[0] == ch;
+    }
+
+    [[nodiscard]] constexpr bool starts_with(const BasicStringView prefix) const noexcept
+    {
+        return prefix.size() <= size_ && BasicStringView{data_, prefix.size()} == prefix;
+    }
+
+    [[nodiscard]] constexpr bool ends_with(const CharT ch) const noexcept
+    {
+        return !empty() && data_[size_ - 1] == ch;
+    }
+
+    [[nodiscard]] constexpr bool ends_with(const BasicStringView suffix) const noexcept
+    {
+        return suffix.size() <= size_ && BasicStringView{data_ + size_ - suffix.size(), suffix.size()} == suffix;
+    }
+
+    // Whitespace: ' ', '\t', '\n', '\v', '\f', '\r'
+    [[nodiscard]] constexpr BasicStringView trim_left() const noexcept
+    {
+        size_t idx = 0;
+        while (idx < size_ && is_space(data_[idx]))
+        {
+            idx++;
+        }
+        return BasicStringView{data_ + idx, size_ - idx};
+    }
+
+    [[nodiscard]] constexpr BasicStringView trim_right() const noexcept
+    {
+        size_t length = size_;
+        while (length > 0 && is_space(data_[length - 1]))
+        {
+            length--;
+        }
+        return BasicStringView{data_, length};
+    }
+
+    [[nodiscard]] constexpr BasicStringView trim() const noexcept
+    {
+        return trim_left().trim_right();
+    }
+
+    [[nodiscard]] SplitRange<CharT, CharT> split(const CharT delimiter) const noexcept
+    {
+        return SplitRange<CharT, CharT>{*this, delimiter, false};
+    }
+
+    [[nodiscard]] SplitRange<CharT, BasicStringView> split(const BasicStringView delimiter) const noexcept
+    {
+        return SplitRange<CharT, BasicStringView>{*this, delimiter, false};
+    }
+
+    [[nodiscard]] SplitRange<CharT, CharT> tokenize(const CharT delimiter) const noexcept
+    {
+        return SplitRange<CharT, CharT>{*this, delimiter, true};
+    }
+
+    [[nodiscard]] SplitRange<CharT, BasicStringView> tokenize(const BasicStringView delimiter) const noexcept
+    {
+        return SplitRange<CharT, BasicStringView>{*this, delimiter, true};
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const BasicStringView lhs, const BasicStringView rhs) noexcept
+    {
+        if (lhs.size_ != rhs.size_)
+        {
+            return false;
+        }
+
+        for (size_t idx = 0; idx < lhs.size_; idx++)
+        {
+            if (lhs.data_[idx] != rhs.data_[idx])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    template <typename, typename>
+    friend class SplitRange;
+
+    static constexpr size_t length(const CharT* c_string) noexcept
+    {
+        if (c_string == nullptr)
+        {
+            return 0;
+        }
+
+        size_t length = 0;
+        while (c_string[length] != CharT{})
+        {
+            length++;
+        }
+        return length;
+    }
+
+    static constexpr bool is_space(const CharT ch) noexcept
+    {
+        return ch == CharT(' ') || ch == CharT('\t') || ch == CharT('\n') || ch == CharT('\v') || ch == CharT('\f') ||
+               ch == CharT('\r');
+    }
+
+    static constexpr size_t delimiter_size(const CharT) noexcept
+    {
+        return 1;
+    }
+
+    static constexpr size_t delimiter_size(const BasicStringView delimiter) noexcept
+    {
+        return delimiter.size();
+    }
+
+private:
+    const CharT* data_{nullptr};
+    size_t size_{0};
+};
+
+using StringView = BasicStringView<char>;
+
+}  // namespace erturk::container
+
+#endif  // ERTURK_STRING_VIEW_H
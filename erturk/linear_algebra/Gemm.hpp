@@ -0,0 +1,475 @@
+#ifndef ERTURK_GEMM_H
+#define ERTURK_GEMM_H
+
+#include "../vectorization/CpuFeatures.hpp"
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(ERTURK_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+/*
+Single precision general matrix multiply: C = alpha * A * B + beta * C, A is m x k, B is k x n, C is m x n.
+
+Every matrix is addressed with a row and a column stride, element (i, j) lives at data[i * row_stride + j * col_stride],
+so row-major, column-major and transposed operands are all served by the same routine.
+
+Blocking follows the Goto/BLIS layering:
+    jc loop : NC columns of B and C            (B panel sized for L3)
+    pc loop : KC depth                         (packed B panel, KC x NC, shared by every thread)
+    ic loop : MC rows of A and C               (packed A block, MC x KC, private per thread, sized for L2)
+    jr, ir  : NR x MR register tile computed by the micro-kernel, one KC long sliver of A and B (L1)
+
+Packing copies each panel into contiguous, zero padded MR/NR wide slivers, so the micro-kernel only streams aligned
+memory and arbitrary m, n, k need no special case inside the hot loop: partial tiles are computed into a local tile
+and merged into C.
+
+The AVX2/FMA micro-kernel (6 x 16, 12 accumulators) is selected at run time, hosts without it use a portable kernel.
+Work is split by rows of C across threads, B panels are packed cooperatively and synchronized with a barrier.
+*/
+namespace erturk::linear_algebra
+{
+
+namespace gemm_detail
+{
+
+inline constexpr size_t MR_ = 6;
+inline constexpr size_t NR_ = 16;
+inline constexpr size_t KC_ = 256;
+inline constexpr size_t MC_ = 144;   // multiple of MR_
+inline constexpr size_t NC_ = 3072;  // multiple of NR_
+inline constexpr size_t BUFFER_ALIGNMENT_ = 64;
+inline constexpr size_t MIN_FLOPS_PER_THREAD_ = size_t{1} << 23;
+
+using MicroKernel = void (*)(size_t kc, const float* a, const float* b, float* c, ptrdiff_t c_row_stride, float alpha,
+                             float beta);
+
+// Cache line aligned scratch memory for packed panels
+class PackedBuffer
+{
+   public:
+    explicit PackedBuffer(const size_t count)
+    {
+        const size_t bytes = ((count * sizeof(float) + BUFFER_ALIGNMENT_ - 1) / BUFFER_ALIGNMENT_) * BUFFER_ALIGNMENT_;
+        data_ = static_cast<float*>(std::aligned_alloc(BUFFER_ALIGNMENT_, bytes));
+        if (data_ == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate memory!");
+        }
+    }
+
+    PackedBuffer(const PackedBuffer&) = delete;
+    PackedBuffer& operator=(const PackedBuffer&) = delete;
+
+    ~PackedBuffer()
+    {
+        std::free(data_);
+    }
+
+    [[nodiscard]] float* data() const noexcept
+    {
+        return data_;
+    }
+
+   private:
+    float* data_{nullptr};
+};
+
+// c[i * c_row_stride + j] = alpha * sum(a * b) + beta * c, c is only read when beta != 0
+inline void micro_kernel_portable(const size_t kc, const float* a, const float* b, float* c,
+                                  const ptrdiff_t c_row_stride, const float alpha, const float beta)
+{
+    float accumulator[MR_][NR_] = {};
+
+    for (size_t p = 0; p < kc; p++)
+    {
+        for (size_t i = 0; i < MR_; i++)
+        {
+            const float a_value = a[i];
+            for (size_t j = 0; j < NR_; j++)
+            {
+                accumulator[i][j] += a_value * b[j];
+            }
+        }
+        a += MR_;
+        b += NR_;
+    }
+
+    for (size_t i = 0; i < MR_; i++)
+    {
+        float* c_row = c + static_cast<ptrdiff_t>(i) * c_row_stride;
+        for (size_t j = 0; j < NR_; j++)
+        {
+            c_row[j] = beta == 0.0f ? alpha * accumulator[i][j] : alpha * accumulator[i][j] + beta * c_row[j];
+        }
+    }
+}
+
+#if defined(ERTURK_SIMD_X86)
+
+ERTURK_TARGET_AVX2 inline void store_row_avx2(float* c_row, const __m256 low, const __m256 high, const __m256 alpha,
+                                              const float beta)
+{
+    if (beta == 0.0f)
+    {
+        _mm256_storeu_ps(c_row, _mm256_mul_ps(alpha, low));
+        _mm256_storeu_ps(c_row + 8, _mm256_mul_ps(alpha, high));
+        return;
+    }
+
+    const __m256 beta_v = _mm256_set1_ps(beta);
+    _mm256_storeu_ps(c_row, _mm256_fmadd_ps(alpha, low, _mm256_mul_ps(beta_v, _mm256_loadu_ps(c_row))));
+    _mm256_storeu_ps(c_row + 8, _mm256_fmadd_ps(alpha, high, _mm256_mul_ps(beta_v, _mm256_loadu_ps(c_row + 8))));
+}
+
+// 6 x 16 tile: 12 ymm accumulators, 2 ymm for the B row, 1 ymm for the broadcast A value
+ERTURK_TARGET_AVX2 __attribute__((flatten)) inline void micro_kernel_avx2(const size_t kc, const float* a,
+                                                                            const float* b, float* c,
+                                                                            const ptrdiff_t c_row_stride,
+                                                                            const float alpha, const float beta)
+{
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (size_t p = 0; p < kc; p++)
+    {
+        const __m256 b0 = _mm256_load_ps(b);
+        const __m256 b1 = _mm256_load_ps(b + 8);
+        _mm_prefetch(reinterpret_cast<const char*>(b + 8 * NR_), _MM_HINT_T0);
+
+        __m256 av = _mm256_broadcast_ss(a);
+        c00 = _mm256_fmadd_ps(av, b0, c00);
+        c01 = _mm256_fmadd_ps(av, b1, c01);
+        av = _mm256_broadcast_ss(a + 1);
+        c10 = _mm256_fmadd_ps(av, b0, c10);
+        c11 = _mm256_fmadd_ps(av, b1, c11);
+        av = _mm256_broadcast_ss(a + 2);
+        c20 = _mm256_fmadd_ps(av, b0, c20);
+        c21 = _mm256_fmadd_ps(av, b1, c21);
+        av = _mm256_broadcast_ss(a + 3);
+        c30 = _mm256_fmadd_ps(av, b0, c30);
+        c31 = _mm256_fmadd_ps(av, b1, c31);
+        av = _mm256_broadcast_ss(a + 4);
+        c40 = _mm256_fmadd_ps(av, b0, c40);
+        c41 = _mm256_fmadd_ps(av, b1, c41);
+        av = _mm256_broadcast_ss(a + 5);
+        c50 = _mm256_fmadd_ps(av, b0, c50);
+        c51 = _mm256_fmadd_ps(av, b1, c51);
+
+        a += MR_;
+        b += NR_;
+    }
+
+    const __m256 alpha_v = _mm256_set1_ps(alpha);
+    store_row_avx2(c, c00, c01, alpha_v, beta);
+    store_row_avx2(c + c_row_stride, c10, c11, alpha_v, beta);
+    store_row_avx2(c + 2 * c_row_stride, c20, c21, alpha_v, beta);
+    store_row_avx2(c + 3 * c_row_stride, c30, c31, alpha_v, beta);
+    store_row_avx2(c + 4 * c_row_stride, c40, c41, alpha_v, beta);
+    store_row_avx2(c + 5 * c_row_stride, c50, c51, alpha_v, beta);
+}
+
+#endif
+
+inline MicroKernel select_micro_kernel() noexcept
+{
+#if defined(ERTURK_SIMD_X86)
+    if (simd::cpu::instruction_set() >= simd::cpu::InstructionSet::AVX2)
+    {
+        return micro_kernel_avx2;
+    }
+#endif
+    return micro_kernel_portable;
+}
+
+inline MicroKernel micro_kernel() noexcept
+{
+    static const MicroKernel kernel = select_micro_kernel();
+    return kernel;
+}
+
+struct Operand
+{
+    const float* data;
+    ptrdiff_t row_stride;
+    ptrdiff_t col_stride;
+
+    [[nodiscard]] float at(const size_t row, const size_t col) const noexcept
+    {
+        return data[static_cast<ptrdiff_t>(row) * row_stride + static_cast<ptrdiff_t>(col) * col_stride];
+    }
+};
+
+// mc x kc block of A (starting at row, depth) as MR_ tall slivers, each sliver stored column by column
+inline void pack_a(const Operand& a, const size_t row, const size_t depth, const size_t mc, const size_t kc,
+                   float* packed) noexcept
+{
+    for (size_t ir = 0; ir < mc; ir += MR_)
+    {
+        const size_t mr = std::min(MR_, mc - ir);
+        for (size_t p = 0; p < kc; p++)
+        {
+            for (size_t i = 0; i < MR_; i++)
+            {
+                packed[i] = i < mr ? a.at(row + ir + i, depth + p) : 0.0f;
+            }
+            packed += MR_;
+        }
+    }
+}
+
+// Slivers [first_sliver, last_sliver) of the kc x nc panel of B as NR_ wide slivers, each stored row by row
+inline void pack_b(const Operand& b, const size_t depth, const size_t col, const size_t kc, const size_t nc,
+                   const size_t first_sliver, const size_t last_sliver, float* packed) noexcept
+{
+    for (size_t sliver = first_sliver; sliver < last_sliver; sliver++)
+    {
+        const size_t jr = sliver * NR_;
+        const size_t nr = std::min(NR_, nc - jr);
+        float* destination = packed + sliver * NR_ * kc;
+
+        for (size_t p = 0; p < kc; p++)
+        {
+            if (nr == NR_ && b.col_stride == 1)
+            {
+                std::copy_n(&b.data[static_cast<ptrdiff_t>(depth + p) * b.row_stride + static_cast<ptrdiff_t>(col + jr)],
+                            NR_, destination);
+            }
+            else
+            {
+                for (size_t j = 0; j < NR_; j++)
+                {
+                    destination[j] = j < nr ? b.at(depth + p, col + jr + j) : 0.0f;
+                }
+            }
+            destination += NR_;
+        }
+    }
+}
+
+struct Problem
+{
+    size_t m;
+    size_t n;
+    size_t k;
+    float alpha;
+    Operand a;
+    Operand b;
+    float beta;
+    float* c;
+    ptrdiff_t c_row_stride;
+    ptrdiff_t c_col_stride;
+};
+
+// C block (row, col) of mc x nc from packed A block and packed B panel
+inline void macro_kernel(const Problem& problem, const size_t row, const size_t col, const size_t mc, const size_t nc,
+                         const size_t kc, const float* packed_a, const float* packed_b, const float beta,
+                         const MicroKernel kernel)
+{
+    alignas(BUFFER_ALIGNMENT_) float tile[MR_ * NR_];
+
+    for (size_t jr = 0; jr < nc; jr += NR_)
+    {
+        const size_t nr = std::min(NR_, nc - jr);
+        const float* b_sliver = packed_b + jr * kc;
+
+        for (size_t ir = 0; ir < mc; ir += MR_)
+        {
+            const size_t mr = std::min(MR_, mc - ir);
+            const float* a_sliver = packed_a + ir * kc;
+            float* c_tile = problem.c + static_cast<ptrdiff_t>(row + ir) * problem.c_row_stride +
+                            static_cast<ptrdiff_t>(col + jr) * problem.c_col_stride;
+
+            if (mr == MR_ && nr == NR_ && problem.c_col_stride == 1)
+            {
+                kernel(kc, a_sliver, b_sliver, c_tile, problem.c_row_stride, problem.alpha, beta);
+                continue;
+            }
+
+            // Partial or strided tile : compute locally, merge the valid part
+            kernel(kc, a_sliver, b_sliver, tile, static_cast<ptrdiff_t>(NR_), 1.0f, 0.0f);
+            for (size_t i = 0; i < mr; i++)
+            {
+                for (size_t j = 0; j < nr; j++)
+                {
+                    float& target = c_tile[static_cast<ptrdiff_t>(i) * problem.c_row_stride +
+                                           static_cast<ptrdiff_t>(j) * problem.c_col_stride];
+                    const float product = problem.alpha * tile[i * NR_ + j];
+                    target = beta == 0.0f ? product : product + beta * target;
+                }
+            }
+        }
+    }
+}
+
+// Splits [0, count) into thread_count nearly equal parts and returns part "index"
+inline std::pair<size_t, size_t> partition(const size_t count, const size_t index, const size_t thread_count) noexcept
+{
+    return {count * index / thread_count, count * (index + 1) / thread_count};
+}
+
+inline void run_thread(const Problem& problem, float* packed_a, float* packed_b, const size_t thread_index,
+                       const size_t thread_count, std::barrier<>* sync)
+{
+    const MicroKernel kernel = micro_kernel();
+
+    // Rows of C owned by this thread, in whole MR_ slivers
+    const size_t row_slivers = (problem.m + MR_ - 1) / MR_;
+    const auto [first_row_sliver, last_row_sliver] = partition(row_slivers, thread_index, thread_count);
+    const size_t row_begin = std::min(problem.m, first_row_sliver * MR_);
+    const size_t row_end = std::min(problem.m, last_row_sliver * MR_);
+
+    for (size_t jc = 0; jc < problem.n; jc += NC_)
+    {
+        const size_t nc = std::min(NC_, problem.n - jc);
+        const size_t col_slivers = (nc + NR_ - 1) / NR_;
+
+        for (size_t pc = 0; pc < problem.k; pc += KC_)
+        {
+            const size_t kc = std::min(KC_, problem.k - pc);
+            const float beta = pc == 0 ? problem.beta : 1.0f;
+
+            const auto [first_col_sliver, last_col_sliver] = partition(col_slivers, thread_index, thread_count);
+            pack_b(problem.b, pc, jc, kc, nc, first_col_sliver, last_col_sliver, packed_b);
+            if (sync != nullptr)
+            {
+                sync->arrive_and_wait();  // B panel complete
+            }
+
+            for (size_t ic = row_begin; ic < row_end; ic += MC_)
+            {
+                const size_t mc = std::min(MC_, row_end - ic);
+                pack_a(problem.a, ic, pc, mc, kc, packed_a);
+                macro_kernel(problem, ic, jc, mc, nc, kc, packed_a, packed_b, beta, kernel);
+            }
+
+            if (sync != nullptr)
+            {
+                sync->arrive_and_wait();  // B panel no longer read
+            }
+        }
+    }
+}
+
+// Never more threads than MR_ row slivers, automatic count also keeps MIN_FLOPS_PER_THREAD_ of work per thread
+inline size_t resolve_thread_count(const Problem& problem, const size_t requested) noexcept
+{
+    const size_t by_rows = (problem.m + MR_ - 1) / MR_;
+    if (requested != 0)
+    {
+        return std::min(requested, by_rows);
+    }
+
+    const size_t by_work = std::max<size_t>(1, 2 * problem.m * problem.n * problem.k / MIN_FLOPS_PER_THREAD_);
+    const size_t available = std::max(1U, std::thread::hardware_concurrency());
+    return std::min({available, by_rows, by_work});
+}
+
+// C = beta * C, used when k == 0 (or alpha == 0)
+inline void scale(const Problem& problem)
+{
+    for (size_t i = 0; i < problem.m; i++)
+    {
+        for (size_t j = 0; j < problem.n; j++)
+        {
+            float& target = problem.c[static_cast<ptrdiff_t>(i) * problem.c_row_stride +
+                                      static_cast<ptrdiff_t>(j) * problem.c_col_stride];
+            target = problem.beta == 0.0f ? 0.0f : problem.beta * target;
+        }
+    }
+}
+
+}  // namespace gemm_detail
+
+/*
+C = alpha * A * B + beta * C with explicit strides, element (i, j) of X is X[i * x_row_stride + j * x_col_stride].
+thread_count = 0 picks a count from hardware concurrency and problem size, C is not read when beta == 0.
+If a worker thread cannot be started the error is rethrown once the started ones have finished, C is then unspecified.
+*/
+inline void sgemm(const size_t m, const size_t n, const size_t k, const float alpha, const float* a,
+                  const ptrdiff_t a_row_stride, const ptrdiff_t a_col_stride, const float* b, const ptrdiff_t b_row_stride,
+                  const ptrdiff_t b_col_stride, const float beta, float* c, const ptrdiff_t c_row_stride,
+                  const ptrdiff_t c_col_stride, const size_t thread_count = 0)
+{
+    const gemm_detail::Problem problem{
+        m, n, k, alpha, {a, a_row_stride, a_col_stride}, {b, b_row_stride, b_col_stride}, beta, c, c_row_stride,
+        c_col_stride};
+
+    if (m == 0 || n == 0)
+    {
+        return;
+    }
+    if (k == 0 || alpha == 0.0f)
+    {
+        gemm_detail::scale(problem);
+        return;
+    }
+
+    // Every buffer is allocated up front, worker threads never allocate (nor throw)
+    const size_t threads = gemm_detail::resolve_thread_count(problem, thread_count);
+    const size_t packed_a_size = gemm_detail::MC_ * gemm_detail::KC_;
+    const size_t packed_b_width = (std::min(n, gemm_detail::NC_) + gemm_detail::NR_ - 1) / gemm_detail::NR_;
+    gemm_detail::PackedBuffer packed_a(threads * packed_a_size);
+    gemm_detail::PackedBuffer packed_b(gemm_detail::KC_ * packed_b_width * gemm_detail::NR_);
+
+    if (threads == 1)
+    {
+        gemm_detail::run_thread(problem, packed_a.data(), packed_b.data(), 0, 1, nullptr);
+        return;
+    }
+
+    std::barrier<> sync(static_cast<ptrdiff_t>(threads));
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    try
+    {
+        for (size_t idx = 1; idx < threads; idx++)
+        {
+            workers.emplace_back(gemm_detail::run_thread, std::cref(problem), packed_a.data() + idx * packed_a_size,
+                                 packed_b.data(), idx, threads, &sync);
+        }
+    }
+    catch (...)
+    {
+        // Drop the participants that never started (and this thread) so the started ones pass every barrier phase
+        for (size_t idx = workers.size(); idx < threads; idx++)
+        {
+            sync.arrive_and_drop();
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        throw;
+    }
+    gemm_detail::run_thread(problem, packed_a.data(), packed_b.data(), 0, threads, &sync);
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Row-major C (m x n) = A (m x k) * B (k x n), leading dimensions are the row strides
+inline void sgemm(const size_t m, const size_t n, const size_t k, const float* a, const size_t lda, const float* b,
+                  const size_t ldb, float* c, const size_t ldc, const size_t thread_count = 0)
+{
+    sgemm(m, n, k, 1.0f, a, static_cast<ptrdiff_t>(lda), 1, b, static_cast<ptrdiff_t>(ldb), 1, 0.0f, c,
+          static_cast<ptrdiff_t>(ldc), 1, thread_count);
+}
+
+}  // namespace erturk::linear_algebra
+
+#endif  // ERTURK_GEMM_H
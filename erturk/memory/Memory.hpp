@@ -1,9 +1,13 @@
 #ifndef ERTURK_MEMORY_H
 #define ERTURK_MEMORY_H
 
+#include "../meta_types/TypeTrait.hpp"
+#include "VectorizedMemory.hpp"
+#include "VectorizedSearch.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 
 namespace erturk::memory
 {
@@ -15,15 +19,7 @@ inline void* memset(void* destination, const int value, const size_t size)
         return nullptr;
     }
 
-    unsigned char* addr = static_cast<unsigned char*>(destination);
-    const unsigned char val = static_cast<const unsigned char>(value);
-
-    size_t idx = 0;
-    while (size > idx)
-    {
-        *addr++ = val;
-        idx++;
-    }
+    erturk::memory::vectorized::set(destination, value, size);
 
     return destination;
 }
@@ -56,6 +52,15 @@ inline constexpr T* memset(const T* dest_begin, const T* dest_end, const T& valu
 
     T* curr_dest = const_cast<T*>(dest_begin);
 
+    if constexpr (erturk::meta::is_trivially_copyable<T>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            erturk::memory::vectorized::fill_n(curr_dest, value, static_cast<size_t>(dest_end - dest_begin));
+            return const_cast<T*>(dest_end);
+        }
+    }
+
     while (curr_dest != dest_end)
     {
         *curr_dest = value;
@@ -97,6 +102,15 @@ inline constexpr T* memset_n(const T* dest_begin, const Size size, const T& valu
 
     T* curr_dest = const_cast<T*>(dest_begin);
 
+    if constexpr (erturk::meta::is_trivially_copyable<T>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            erturk::memory::vectorized::fill_n(curr_dest, value, static_cast<size_t>(size));
+            return curr_dest + size;
+        }
+    }
+
     size_t idx = 0;
 
     while (size > idx)
@@ -115,15 +129,7 @@ inline void* memcpy(const void* source, void* destination, const size_t size)
         return nullptr;
     }
 
-    char* dest = static_cast<char*>(destination);
-    const char* src = static_cast<const char*>(source);
-
-    size_t idx = 0;
-    while (size > idx)
-    {
-        *dest++ = *src++;
-        idx++;
-    }
+    erturk::memory::vectorized::copy(destination, source, size);
 
     return destination;
 }
@@ -159,6 +165,16 @@ inline constexpr T* memcpy(const T* src_begin, const T* src_end, const T* dest_b
 
     T* curr_dest = const_cast<T*>(dest_begin);
 
+    if constexpr (erturk::meta::is_trivially_copyable<T>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            const size_t count = static_cast<size_t>(src_end - src_begin);
+            erturk::memory::vectorized::copy_n(curr_dest, src_begin, count);
+            return curr_dest + count;
+        }
+    }
+
     while (src_begin != src_end)
     {
         *curr_dest = *src_begin;
@@ -187,7 +203,7 @@ inline constexpr T_Iterator memcpy_n(const T_Iterator src_begin, const Size size
 
         src_begin_++;  // increase to next T memory layout
         curr_dest++;   // increase to next T memory layout
-        idx--;
+        idx++;
     }
     return curr_dest;
 }
@@ -202,6 +218,15 @@ inline constexpr T* memcpy_n(const T* src_begin, const size_t size, const T* des
 
     T* curr_dest = const_cast<T*>(dest_begin);
 
+    if constexpr (erturk::meta::is_trivially_copyable<T>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            erturk::memory::vectorized::copy_n(curr_dest, src_begin, size);
+            return curr_dest + size;
+        }
+    }
+
     size_t idx = 0;
     while (size > idx)
     {
@@ -238,6 +263,27 @@ inline int memcmp(const void* str1, const void* str2, const size_t size)
     return 0;
 }
 
+inline void* memchr(const void* str, const int value, const size_t size)
+{
+    if (str == nullptr || size <= 0)
+    {
+        return nullptr;
+    }
+
+    return const_cast<void*>(erturk::memory::vectorized::find(str, value, size));
+}
+
+// First occurrence of needle in haystack, GNU memmem semantics (empty needle matches at haystack)
+inline void* memmem(const void* haystack, const size_t haystack_size, const void* needle, const size_t needle_size)
+{
+    if (haystack == nullptr)
+    {
+        return nullptr;
+    }
+
+    return const_cast<void*>(erturk::memory::vectorized::search(haystack, haystack_size, needle, needle_size));
+}
+
 /*
 Memory overlapping is source and destination buffers have the same memory addresses.
 
@@ -1,8 +1,12 @@
 #ifndef ERTURK_TYPEBUFFER_MEMORY_H
 #define ERTURK_TYPEBUFFER_MEMORY_H
 
+#include "../meta_types/TypeTrait.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 namespace erturk::type_buffer_memory
 {
@@ -58,16 +62,35 @@ inline constexpr T_Iterator emplace_type_buffers_copy(T_Iterator emplaced_src_be
     }
 }
 
-// Emplace T with copy/move constructor from an already emplaced T array, into address
-template <class T, class T_Iterator, class Size>
-inline constexpr T_Iterator emplace_type_buffers_copy_n(T_Iterator emplaced_src_begin, const Size size,
+// Emplace T with copy/move constructor from an already emplaced T sequence (any input iterator), into address.
+// A contiguous source of trivially copyable T is copied with a single memcpy.
+template <class T, class T_Iterator, class Size, class Src_Iterator = T_Iterator>
+inline constexpr T_Iterator emplace_type_buffers_copy_n(Src_Iterator emplaced_src_begin, const Size size,
                                                         const T_Iterator type_buffer_dest_begin,
                                                         InstantiatePolicy instantiatePolicy = InstantiatePolicy::Copy)
 {
-    if (emplaced_src_begin == nullptr || size <= 0 || type_buffer_dest_begin == nullptr)
+    if constexpr (std::is_pointer_v<Src_Iterator>)
+    {
+        if (emplaced_src_begin == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    if (size <= 0 || type_buffer_dest_begin == nullptr)
     {
         return nullptr;
     }
+
+    if constexpr (erturk::meta::is_trivially_copyable<T>::value && std::is_pointer_v<Src_Iterator> &&
+                  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Src_Iterator>>, T> &&
+                  std::is_same_v<T_Iterator, T*>)
+    {
+        std::memcpy(static_cast<void*>(type_buffer_dest_begin), static_cast<const void*>(emplaced_src_begin),
+                    static_cast<size_t>(size) * sizeof(T));
+        return type_buffer_dest_begin + size;
+    }
+
     T_Iterator curr_type_buffer = type_buffer_dest_begin;
     try
     {
@@ -179,7 +202,7 @@ inline constexpr T_Iterator emplace_type_buffers_n(const T_Iterator type_buffer_
             }
 
             curr_type_buffer++;  // increase to next T memory layout
-            size_++;
+            size_--;
         }
         return curr_type_buffer;
     }
@@ -249,7 +272,7 @@ inline constexpr T_Iterator emplace_type_buffers_n(const T_Iterator type_buffer_
                 T{std::forward<Args>(args)...};  // Emplace T with any constructor into address
 
             curr_type_buffer++;  // increase to next T memory layout
-            size_++;
+            size_--;
         }
         return curr_type_buffer;
     }
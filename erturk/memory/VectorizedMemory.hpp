@@ -0,0 +1,577 @@
+#ifndef ERTURK_VECTORIZED_MEMORY_H
+#define ERTURK_VECTORIZED_MEMORY_H
+
+#include "../vectorization/CpuFeatures.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ERTURK_VECTORIZED_MEMORY_X86
+#endif
+
+/*
+Size-tiered bulk copy/fill engine used behind erturk::memory.
+
+Tiers (bytes):
+- [0, 16]            : at most two overlapping scalar moves (8/4/2/1 bytes), no loop.
+- (16, 4 * WIDTH]    : two or four overlapping vector moves from both ends of the range.
+- (4 * WIDTH, LLC)   : unaligned head store, destination aligned 4x unrolled loop, unaligned tail store.
+- [LLC, ...)         : same loop with non-temporal (streaming) stores, so a huge copy does not evict the whole cache.
+
+AVX2 kernels are compiled with target attributes and selected at runtime (ERTURK_SIMD_ISA caps it like every dispatched
+kernel), SSE2 is the x86_64 baseline.
+Source and destination ranges must not overlap, use memmove for overlapping ranges.
+*/
+namespace erturk::memory::vectorized
+{
+
+namespace detail
+{
+
+inline constexpr size_t SMALL_LIMIT_ = 16;
+inline constexpr size_t UNROLL_ = 4;
+inline constexpr size_t DEFAULT_LLC_SIZE_ = 8 * 1024 * 1024;
+
+inline size_t query_llc_size() noexcept
+{
+    long llc_size = -1;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    if (llc_size <= 0)
+    {
+        llc_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    return llc_size > 0 ? static_cast<size_t>(llc_size) : DEFAULT_LLC_SIZE_;
+}
+
+// Copies of at least this size bypass the cache with non-temporal stores
+inline size_t non_temporal_threshold() noexcept
+{
+    static const size_t threshold = query_llc_size();
+    return threshold;
+}
+
+inline constexpr uint64_t broadcast_byte(const unsigned char value) noexcept
+{
+    return static_cast<uint64_t>(value) * 0x0101010101010101ULL;
+}
+
+// [0, 16] bytes, moves are issued from both ends and may overlap in the middle
+inline void copy_small(unsigned char* dst, const unsigned char* src, const size_t size) noexcept
+{
+    if (size >= 8)
+    {
+        uint64_t head;
+        uint64_t tail;
+        __builtin_memcpy(&head, src, sizeof(head));
+        __builtin_memcpy(&tail, src + size - sizeof(tail), sizeof(tail));
+        __builtin_memcpy(dst, &head, sizeof(head));
+        __builtin_memcpy(dst + size - sizeof(tail), &tail, sizeof(tail));
+    }
+    else if (size >= 4)
+    {
+        uint32_t head;
+        uint32_t tail;
+        __builtin_memcpy(&head, src, sizeof(head));
+        __builtin_memcpy(&tail, src + size - sizeof(tail), sizeof(tail));
+        __builtin_memcpy(dst, &head, sizeof(head));
+        __builtin_memcpy(dst + size - sizeof(tail), &tail, sizeof(tail));
+    }
+    else if (size >= 2)
+    {
+        uint16_t head;
+        uint16_t tail;
+        __builtin_memcpy(&head, src, sizeof(head));
+        __builtin_memcpy(&tail, src + size - sizeof(tail), sizeof(tail));
+        __builtin_memcpy(dst, &head, sizeof(head));
+        __builtin_memcpy(dst + size - sizeof(tail), &tail, sizeof(tail));
+    }
+    else if (size == 1)
+    {
+        *dst = *src;
+    }
+}
+
+// [0, 16] bytes
+inline void set_small(unsigned char* dst, const unsigned char value, const size_t size) noexcept
+{
+    const uint64_t pattern = broadcast_byte(value);
+
+    if (size >= 8)
+    {
+        __builtin_memcpy(dst, &pattern, 8);
+        __builtin_memcpy(dst + size - 8, &pattern, 8);
+    }
+    else if (size >= 4)
+    {
+        __builtin_memcpy(dst, &pattern, 4);
+        __builtin_memcpy(dst + size - 4, &pattern, 4);
+    }
+    else if (size >= 2)
+    {
+        __builtin_memcpy(dst, &pattern, 2);
+        __builtin_memcpy(dst + size - 2, &pattern, 2);
+    }
+    else if (size == 1)
+    {
+        *dst = value;
+    }
+}
+
+#if defined(ERTURK_VECTORIZED_MEMORY_X86)
+
+// ********************************************* SSE2 (16 bytes) *********************************************
+
+// (4 * WIDTH, ...) bytes, kept out of line so that the small tiers do not pay for its register pressure
+__attribute__((noinline)) inline void copy_sse2_large(unsigned char* dst, const unsigned char* src,
+                                                      const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m128i);
+
+    const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + size - WIDTH));
+
+    // Unaligned head store, then advance destination to the next WIDTH boundary
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), head);
+
+    const size_t skew = WIDTH - (reinterpret_cast<uintptr_t>(dst) & (WIDTH - 1));
+    unsigned char* d = dst + skew;
+    const unsigned char* s = src + skew;
+    size_t remaining = size - skew;
+
+    if (size >= non_temporal_threshold())
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + WIDTH));
+            const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * WIDTH));
+            const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * WIDTH));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + WIDTH), v1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 2 * WIDTH), v2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 3 * WIDTH), v3);
+            s += UNROLL_ * WIDTH;
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+        _mm_sfence();  // streaming stores are weakly ordered
+    }
+    else
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + WIDTH));
+            const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * WIDTH));
+            const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * WIDTH));
+            _mm_store_si128(reinterpret_cast<__m128i*>(d), v0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(d + WIDTH), v1);
+            _mm_store_si128(reinterpret_cast<__m128i*>(d + 2 * WIDTH), v2);
+            _mm_store_si128(reinterpret_cast<__m128i*>(d + 3 * WIDTH), v3);
+            s += UNROLL_ * WIDTH;
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+    }
+
+    while (remaining > WIDTH)
+    {
+        _mm_store_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+        s += WIDTH;
+        d += WIDTH;
+        remaining -= WIDTH;
+    }
+
+    // Unaligned tail store, may overlap with the last loop store
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + size - WIDTH), tail);
+}
+
+// (16, ...) bytes
+inline void copy_sse2(unsigned char* dst, const unsigned char* src, const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m128i);
+
+    const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + size - WIDTH));
+
+    if (size <= 2 * WIDTH)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), head);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + size - WIDTH), tail);
+        return;
+    }
+
+    if (size <= 4 * WIDTH)
+    {
+        const __m128i head2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + WIDTH));
+        const __m128i tail2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + size - 2 * WIDTH));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), head);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + WIDTH), head2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + size - 2 * WIDTH), tail2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + size - WIDTH), tail);
+        return;
+    }
+
+    copy_sse2_large(dst, src, size);
+}
+
+// (16, ...) bytes
+inline void set_sse2(unsigned char* dst, const unsigned char value, const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m128i);
+
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), pattern);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + size - WIDTH), pattern);
+
+    if (size <= 2 * WIDTH)
+    {
+        return;
+    }
+
+    const size_t skew = WIDTH - (reinterpret_cast<uintptr_t>(dst) & (WIDTH - 1));
+    unsigned char* d = dst + skew;
+    size_t remaining = size - skew;
+
+    if (size >= non_temporal_threshold())
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), pattern);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + WIDTH), pattern);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 2 * WIDTH), pattern);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 3 * WIDTH), pattern);
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+        _mm_sfence();  // streaming stores are weakly ordered
+    }
+    else
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            _mm_store_si128(reinterpret_cast<__m128i*>(d), pattern);
+            _mm_store_si128(reinterpret_cast<__m128i*>(d + WIDTH), pattern);
+            _mm_store_si128(reinterpret_cast<__m128i*>(d + 2 * WIDTH), pattern);
+            _mm_store_si128(reinterpret_cast<__m128i*>(d + 3 * WIDTH), pattern);
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+    }
+
+    while (remaining > WIDTH)
+    {
+        _mm_store_si128(reinterpret_cast<__m128i*>(d), pattern);
+        d += WIDTH;
+        remaining -= WIDTH;
+    }
+}
+
+// ********************************************* AVX2 (32 bytes) *********************************************
+
+// (4 * WIDTH, ...) bytes, kept out of line so that the small tiers do not pay for its register pressure
+__attribute__((target("avx2"), noinline)) inline void copy_avx2_large(unsigned char* dst, const unsigned char* src,
+                                                                     const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m256i);
+
+    const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + size - WIDTH));
+
+    // Unaligned head store, then advance destination to the next WIDTH boundary
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), head);
+
+    const size_t skew = WIDTH - (reinterpret_cast<uintptr_t>(dst) & (WIDTH - 1));
+    unsigned char* d = dst + skew;
+    const unsigned char* s = src + skew;
+    size_t remaining = size - skew;
+
+    if (size >= non_temporal_threshold())
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+            const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + WIDTH));
+            const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 2 * WIDTH));
+            const __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 3 * WIDTH));
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v0);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + WIDTH), v1);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 2 * WIDTH), v2);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 3 * WIDTH), v3);
+            s += UNROLL_ * WIDTH;
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+        _mm_sfence();  // streaming stores are weakly ordered
+    }
+    else
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+            const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + WIDTH));
+            const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 2 * WIDTH));
+            const __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 3 * WIDTH));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d), v0);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d + WIDTH), v1);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d + 2 * WIDTH), v2);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d + 3 * WIDTH), v3);
+            s += UNROLL_ * WIDTH;
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+    }
+
+    while (remaining > WIDTH)
+    {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        s += WIDTH;
+        d += WIDTH;
+        remaining -= WIDTH;
+    }
+
+    // Unaligned tail store, may overlap with the last loop store
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + size - WIDTH), tail);
+}
+
+// (32, ...) bytes
+__attribute__((target("avx2"))) inline void copy_avx2(unsigned char* dst, const unsigned char* src,
+                                                      const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m256i);
+
+    const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + size - WIDTH));
+
+    if (size <= 2 * WIDTH)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), head);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + size - WIDTH), tail);
+        return;
+    }
+
+    if (size <= 4 * WIDTH)
+    {
+        const __m256i head2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + WIDTH));
+        const __m256i tail2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + size - 2 * WIDTH));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), head);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + WIDTH), head2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + size - 2 * WIDTH), tail2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + size - WIDTH), tail);
+        return;
+    }
+
+    copy_avx2_large(dst, src, size);
+}
+
+// (32, ...) bytes
+__attribute__((target("avx2"))) inline void set_avx2(unsigned char* dst, const unsigned char value,
+                                                     const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m256i);
+
+    const __m256i pattern = _mm256_set1_epi8(static_cast<char>(value));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), pattern);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + size - WIDTH), pattern);
+
+    if (size <= 2 * WIDTH)
+    {
+        return;
+    }
+
+    const size_t skew = WIDTH - (reinterpret_cast<uintptr_t>(dst) & (WIDTH - 1));
+    unsigned char* d = dst + skew;
+    size_t remaining = size - skew;
+
+    if (size >= non_temporal_threshold())
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d), pattern);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + WIDTH), pattern);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 2 * WIDTH), pattern);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 3 * WIDTH), pattern);
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+        _mm_sfence();  // streaming stores are weakly ordered
+    }
+    else
+    {
+        while (remaining > UNROLL_ * WIDTH)
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d), pattern);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d + WIDTH), pattern);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d + 2 * WIDTH), pattern);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d + 3 * WIDTH), pattern);
+            d += UNROLL_ * WIDTH;
+            remaining -= UNROLL_ * WIDTH;
+        }
+    }
+
+    while (remaining > WIDTH)
+    {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d), pattern);
+        d += WIDTH;
+        remaining -= WIDTH;
+    }
+}
+
+// Through the capped level, ERTURK_SIMD_ISA applies to the memory engine like to every dispatched kernel
+inline bool has_avx2() noexcept
+{
+    const erturk::simd::cpu::InstructionSet instruction_set = erturk::simd::cpu::instruction_set();
+    return instruction_set == erturk::simd::cpu::InstructionSet::AVX2 ||
+           instruction_set == erturk::simd::cpu::InstructionSet::AVX512;
+}
+
+#else
+
+// ************************************* Portable (8 byte words) *************************************
+
+// (16, ...) bytes
+inline void copy_words(unsigned char* dst, const unsigned char* src, const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(uint64_t);
+
+    uint64_t tail;
+    __builtin_memcpy(&tail, src + size - WIDTH, WIDTH);
+
+    size_t offset = 0;
+    while (offset + UNROLL_ * WIDTH <= size)
+    {
+        uint64_t words[UNROLL_];
+        __builtin_memcpy(words, src + offset, sizeof(words));
+        __builtin_memcpy(dst + offset, words, sizeof(words));
+        offset += UNROLL_ * WIDTH;
+    }
+
+    while (offset + WIDTH <= size)
+    {
+        uint64_t word;
+        __builtin_memcpy(&word, src + offset, WIDTH);
+        __builtin_memcpy(dst + offset, &word, WIDTH);
+        offset += WIDTH;
+    }
+
+    __builtin_memcpy(dst + size - WIDTH, &tail, WIDTH);
+}
+
+// (16, ...) bytes
+inline void set_words(unsigned char* dst, const unsigned char value, const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(uint64_t);
+
+    const uint64_t pattern = broadcast_byte(value);
+
+    size_t offset = 0;
+    while (offset + WIDTH <= size)
+    {
+        __builtin_memcpy(dst + offset, &pattern, WIDTH);
+        offset += WIDTH;
+    }
+
+    __builtin_memcpy(dst + size - WIDTH, &pattern, WIDTH);
+}
+
+#endif
+
+}  // namespace detail
+
+// Copy "size" bytes from source into destination, ranges must not overlap
+inline void copy(void* destination, const void* source, const size_t size) noexcept
+{
+    unsigned char* dst = static_cast<unsigned char*>(destination);
+    const unsigned char* src = static_cast<const unsigned char*>(source);
+
+    if (size <= detail::SMALL_LIMIT_)
+    {
+        detail::copy_small(dst, src, size);
+        return;
+    }
+
+#if defined(ERTURK_VECTORIZED_MEMORY_X86)
+    if (size > 2 * sizeof(__m128i) && detail::has_avx2())
+    {
+        detail::copy_avx2(dst, src, size);
+        return;
+    }
+    detail::copy_sse2(dst, src, size);
+#else
+    detail::copy_words(dst, src, size);
+#endif
+}
+
+// Fill "size" bytes of destination with (unsigned char)value
+inline void set(void* destination, const int value, const size_t size) noexcept
+{
+    unsigned char* dst = static_cast<unsigned char*>(destination);
+    const unsigned char val = static_cast<unsigned char>(value);
+
+    if (size <= detail::SMALL_LIMIT_)
+    {
+        detail::set_small(dst, val, size);
+        return;
+    }
+
+#if defined(ERTURK_VECTORIZED_MEMORY_X86)
+    if (size > 2 * sizeof(__m128i) && detail::has_avx2())
+    {
+        detail::set_avx2(dst, val, size);
+        return;
+    }
+    detail::set_sse2(dst, val, size);
+#else
+    detail::set_words(dst, val, size);
+#endif
+}
+
+// Typed copy for trivially copyable T
+template <typename T>
+inline void copy_n(T* destination, const T* source, const size_t count) noexcept
+{
+    copy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+}
+
+// Typed fill for trivially copyable T, seeds the first element then doubles the filled prefix with bulk copies
+template <typename T>
+inline void fill_n(T* destination, const T& value, const size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if constexpr (sizeof(T) == 1)
+    {
+        unsigned char byte;
+        __builtin_memcpy(&byte, &value, 1);
+        set(destination, byte, count);
+    }
+    else
+    {
+        __builtin_memcpy(static_cast<void*>(destination), &value, sizeof(T));
+
+        size_t filled = 1;
+        while (filled < count)
+        {
+            const size_t chunk = (filled <= count - filled) ? filled : count - filled;
+            copy(static_cast<void*>(destination + filled), static_cast<const void*>(destination), chunk * sizeof(T));
+            filled += chunk;
+        }
+    }
+}
+
+}  // namespace erturk::memory::vectorized
+
+#undef ERTURK_VECTORIZED_MEMORY_X86
+
+#endif  // ERTURK_VECTORIZED_MEMORY_H
@@ -0,0 +1,475 @@
+#ifndef ERTURK_VECTORIZED_SEARCH_H
+#define ERTURK_VECTORIZED_SEARCH_H
+
+#include "VectorizedMemory.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(ERTURK_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+/*
+Byte search engine used behind erturk::memory::memchr/memmem and String::find_first.
+
+- find   : memchr, compares 4 vectors per iteration and finishes with one overlapping vector from the end.
+- search : memmem, tiered by needle length:
+           1                     : find.
+           [2, LONG_NEEDLE_)     : SIMD first/last byte filter. The first and last needle bytes are compared against two
+                                   shifted haystack vectors, only positions where both match are verified with memcmp.
+           [LONG_NEEDLE_, ...)   : Boyer-Moore-Horspool, skips up to needle length bytes per probe.
+           Without SIMD the filter is replaced by a first byte scan plus memcmp.
+
+No load reaches past haystack + size. AVX2 kernels are selected at runtime, SSE2 is the x86_64 baseline, other targets
+use 8 byte word (SWAR) scans.
+*/
+namespace erturk::memory::vectorized
+{
+
+namespace detail
+{
+
+// The vector filter outruns Horspool up to ~100 byte needles, the word scan only for very short ones
+#if defined(ERTURK_SIMD_X86)
+inline constexpr size_t LONG_NEEDLE_ = 96;
+#else
+inline constexpr size_t LONG_NEEDLE_ = 8;
+#endif
+inline constexpr size_t BYTE_VALUES_ = 256;
+
+inline const unsigned char* find_byte_scalar(const unsigned char* haystack, const unsigned char value,
+                                             const size_t size) noexcept
+{
+    for (size_t idx = 0; idx < size; idx++)
+    {
+        if (haystack[idx] == value)
+        {
+            return haystack + idx;
+        }
+    }
+    return nullptr;
+}
+
+// Verifies candidates of the first byte one by one, used for short haystacks and vector tails
+inline const unsigned char* search_scalar(const unsigned char* haystack, const size_t size,
+                                          const unsigned char* needle, const size_t needle_size) noexcept
+{
+    if (needle_size > size)
+    {
+        return nullptr;
+    }
+
+    const size_t last_position = size - needle_size;
+    for (size_t position = 0; position <= last_position; position++)
+    {
+        if (haystack[position] == needle[0] &&
+            __builtin_memcmp(haystack + position + 1, needle + 1, needle_size - 1) == 0)
+        {
+            return haystack + position;
+        }
+    }
+    return nullptr;
+}
+
+// Tuned Boyer-Moore-Horspool (Hume and Sunday): the last needle byte has shift 0, so the skip loop needs no compare
+inline const unsigned char* search_horspool(const unsigned char* haystack, const size_t size,
+                                            const unsigned char* needle, const size_t needle_size) noexcept
+{
+    if (needle_size > size)
+    {
+        return nullptr;
+    }
+
+    // Shift by the distance of the probed byte from the needle end, needle length for bytes not in the needle
+    uint32_t shift[BYTE_VALUES_];
+    for (uint32_t& entry : shift)
+    {
+        entry = static_cast<uint32_t>(needle_size);
+    }
+    for (size_t idx = 0; idx + 1 < needle_size; idx++)
+    {
+        shift[needle[idx]] = static_cast<uint32_t>(needle_size - 1 - idx);
+    }
+
+    const unsigned char last = needle[needle_size - 1];
+    const size_t last_shift = shift[last];
+    shift[last] = 0;
+
+    const unsigned char* probe = haystack + needle_size - 1;
+    const unsigned char* const probe_end = haystack + size;
+    while (probe < probe_end)
+    {
+        const uint32_t skip = shift[*probe];
+        if (skip != 0)
+        {
+            probe += skip;
+            continue;
+        }
+
+        const unsigned char* candidate = probe - (needle_size - 1);
+        if (__builtin_memcmp(candidate, needle, needle_size - 1) == 0)
+        {
+            return candidate;
+        }
+        probe += last_shift;
+    }
+    return nullptr;
+}
+
+#if defined(ERTURK_SIMD_X86)
+
+// ************************************* SSE2 *************************************
+
+inline const unsigned char* find_byte_sse2(const unsigned char* haystack, const unsigned char value,
+                                           const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m128i);
+
+    if (size < WIDTH)
+    {
+        return find_byte_scalar(haystack, value, size);
+    }
+
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+
+    size_t idx = 0;
+    for (; idx + UNROLL_ * WIDTH <= size; idx += UNROLL_ * WIDTH)
+    {
+        const __m128i eq0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx)), pattern);
+        const __m128i eq1 =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx + WIDTH)), pattern);
+        const __m128i eq2 =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx + 2 * WIDTH)), pattern);
+        const __m128i eq3 =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx + 3 * WIDTH)), pattern);
+
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3))) == 0)
+        {
+            continue;
+        }
+
+        // Combine the four 16 bit masks, the lowest set bit is the first match
+        const uint64_t mask = static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(eq0))) |
+                              static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(eq1))) << 16 |
+                              static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(eq2))) << 32 |
+                              static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(eq3))) << 48;
+        return haystack + idx + __builtin_ctzll(mask);
+    }
+
+    for (; idx + WIDTH <= size; idx += WIDTH)
+    {
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx)), pattern)));
+        if (mask != 0)
+        {
+            return haystack + idx + __builtin_ctz(mask);
+        }
+    }
+
+    if (idx < size)
+    {
+        // Last vector overlaps already checked bytes, none of them matched
+        const size_t base = size - WIDTH;
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + base)), pattern)));
+        if (mask != 0)
+        {
+            return haystack + base + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+
+inline const unsigned char* search_sse2(const unsigned char* haystack, const size_t size,
+                                        const unsigned char* needle, const size_t needle_size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m128i);
+
+    const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+
+    size_t idx = 0;
+    for (; idx + needle_size - 1 + WIDTH <= size; idx += WIDTH)
+    {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + idx + needle_size - 1));
+
+        auto mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+        while (mask != 0)
+        {
+            const size_t position = idx + __builtin_ctz(mask);
+            if (__builtin_memcmp(haystack + position + 1, needle + 1, needle_size - 2) == 0)
+            {
+                return haystack + position;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    const unsigned char* found = search_scalar(haystack + idx, size - idx, needle, needle_size);
+    return found;
+}
+
+// ************************************* AVX2 *************************************
+
+__attribute__((target("avx2"))) inline const unsigned char* find_byte_avx2(const unsigned char* haystack,
+                                                                           const unsigned char value,
+                                                                           const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m256i);
+
+    const __m256i pattern = _mm256_set1_epi8(static_cast<char>(value));
+
+    size_t idx = 0;
+    for (; idx + UNROLL_ * WIDTH <= size; idx += UNROLL_ * WIDTH)
+    {
+        const __m256i eq0 =
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx)), pattern);
+        const __m256i eq1 =
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx + WIDTH)), pattern);
+        const __m256i eq2 = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx + 2 * WIDTH)), pattern);
+        const __m256i eq3 = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx + 3 * WIDTH)), pattern);
+
+        const __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+        if (_mm256_testz_si256(any, any))
+        {
+            continue;
+        }
+
+        const uint64_t low = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eq0))) |
+                             static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eq1))) << 32;
+        if (low != 0)
+        {
+            return haystack + idx + __builtin_ctzll(low);
+        }
+        const uint64_t high = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eq2))) |
+                              static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(eq3))) << 32;
+        return haystack + idx + 2 * WIDTH + __builtin_ctzll(high);
+    }
+
+    for (; idx + WIDTH <= size; idx += WIDTH)
+    {
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx)), pattern)));
+        if (mask != 0)
+        {
+            return haystack + idx + __builtin_ctz(mask);
+        }
+    }
+
+    if (idx < size)
+    {
+        // Last vector overlaps already checked bytes, none of them matched
+        const size_t base = size - WIDTH;
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + base)), pattern)));
+        if (mask != 0)
+        {
+            return haystack + base + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+
+__attribute__((target("avx2"))) inline const unsigned char* search_avx2(const unsigned char* haystack,
+                                                                        const size_t size,
+                                                                        const unsigned char* needle,
+                                                                        const size_t needle_size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(__m256i);
+
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+
+    size_t idx = 0;
+    for (; idx + needle_size - 1 + WIDTH <= size; idx += WIDTH)
+    {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx));
+        const __m256i block_last =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + idx + needle_size - 1));
+
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+        while (mask != 0)
+        {
+            const size_t position = idx + __builtin_ctz(mask);
+            if (__builtin_memcmp(haystack + position + 1, needle + 1, needle_size - 2) == 0)
+            {
+                return haystack + position;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    // Fewer than WIDTH candidate positions left
+    return search_sse2(haystack + idx, size - idx, needle, needle_size);
+}
+
+#else
+
+// ************************************* Portable (8 byte words) *************************************
+
+inline const unsigned char* find_byte_words(const unsigned char* haystack, const unsigned char value,
+                                            const size_t size) noexcept
+{
+    constexpr size_t WIDTH = sizeof(uint64_t);
+    constexpr uint64_t LOW_BITS = broadcast_byte(0x01);
+    constexpr uint64_t HIGH_BITS = broadcast_byte(0x80);
+
+    const uint64_t pattern = broadcast_byte(value);
+
+    size_t idx = 0;
+    for (; idx + WIDTH <= size; idx += WIDTH)
+    {
+        uint64_t word;
+        __builtin_memcpy(&word, haystack + idx, sizeof(word));
+
+        // Non zero when some byte of word equals value
+        const uint64_t diff = word ^ pattern;
+        if (((diff - LOW_BITS) & ~diff & HIGH_BITS) != 0)
+        {
+            return find_byte_scalar(haystack + idx, value, WIDTH);
+        }
+    }
+    return find_byte_scalar(haystack + idx, value, size - idx);
+}
+
+#endif
+
+inline const unsigned char* find_byte(const unsigned char* haystack, const unsigned char value,
+                                      const size_t size) noexcept
+{
+#if defined(ERTURK_SIMD_X86)
+    if (size >= sizeof(__m256i) && has_avx2())
+    {
+        return find_byte_avx2(haystack, value, size);
+    }
+    return find_byte_sse2(haystack, value, size);
+#else
+    return find_byte_words(haystack, value, size);
+#endif
+}
+
+}  // namespace detail
+
+// First occurrence of (unsigned char)value in the first "size" bytes of haystack, nullptr if none
+inline const void* find(const void* haystack, const int value, const size_t size) noexcept
+{
+    if (haystack == nullptr)
+    {
+        return nullptr;
+    }
+    return detail::find_byte(static_cast<const unsigned char*>(haystack), static_cast<unsigned char>(value), size);
+}
+
+// First occurrence of needle in the first "size" bytes of haystack, haystack for an empty needle, nullptr if none
+inline const void* search(const void* haystack, const size_t size, const void* needle,
+                          const size_t needle_size) noexcept
+{
+    if (haystack == nullptr || (needle == nullptr && needle_size != 0))
+    {
+        return nullptr;
+    }
+
+    const auto* hay = static_cast<const unsigned char*>(haystack);
+    const auto* pattern = static_cast<const unsigned char*>(needle);
+
+    if (needle_size == 0)
+    {
+        return hay;
+    }
+    if (needle_size > size)
+    {
+        return nullptr;
+    }
+    if (needle_size == 1)
+    {
+        return detail::find_byte(hay, pattern[0], size);
+    }
+    if (needle_size >= detail::LONG_NEEDLE_)
+    {
+        return detail::search_horspool(hay, size, pattern, needle_size);
+    }
+
+#if defined(ERTURK_SIMD_X86)
+    if (detail::has_avx2())
+    {
+        return detail::search_avx2(hay, size, pattern, needle_size);
+    }
+    return detail::search_sse2(hay, size, pattern, needle_size);
+#else
+    const unsigned char* position = hay;
+    const unsigned char* const end = hay + size - needle_size + 1;  // past the last candidate
+    while (position < end)
+    {
+        position = detail::find_byte(position, pattern[0], static_cast<size_t>(end - position));
+        if (position == nullptr)
+        {
+            return nullptr;
+        }
+        if (__builtin_memcmp(position + 1, pattern + 1, needle_size - 1) == 0)
+        {
+            return position;
+        }
+        position++;
+    }
+    return nullptr;
+#endif
+}
+
+// Typed find for trivially copyable T, byte values use the vectorized scan
+template <typename T>
+inline const T* find_n(const T* haystack, const size_t count, const T& value) noexcept
+{
+    if constexpr (sizeof(T) == 1)
+    {
+        unsigned char byte;
+        __builtin_memcpy(&byte, &value, 1);
+        return static_cast<const T*>(find(haystack, byte, count));
+    }
+    else
+    {
+        for (size_t idx = 0; idx < count; idx++)
+        {
+            if (haystack[idx] == value)
+            {
+                return haystack + idx;
+            }
+        }
+        return nullptr;
+    }
+}
+
+// Typed search for trivially copyable T, byte matches that do not start on an element boundary are skipped
+template <typename T>
+inline const T* search_n(const T* haystack, const size_t count, const T* needle, const size_t needle_count) noexcept
+{
+    const auto* base = reinterpret_cast<const unsigned char*>(haystack);
+    const size_t size = count * sizeof(T);
+    const size_t needle_size = needle_count * sizeof(T);
+
+    size_t offset = 0;
+    while (offset <= size)
+    {
+        const auto* found = static_cast<const unsigned char*>(search(base + offset, size - offset, needle, needle_size));
+        if (found == nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto position = static_cast<size_t>(found - base);
+        if (position % sizeof(T) == 0)
+        {
+            return haystack + position / sizeof(T);
+        }
+        offset = (position / sizeof(T) + 1) * sizeof(T);
+    }
+    return nullptr;
+}
+
+}  // namespace erturk::memory::vectorized
+
+#endif  // ERTURK_VECTORIZED_SEARCH_H
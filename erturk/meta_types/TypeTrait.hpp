@@ -2,6 +2,7 @@
 #define ERTURK_META_H
 
 #include <cstddef>
+#include <type_traits>
 
 namespace erturk
 {
@@ -382,6 +383,12 @@ struct is_trivially_copyable_impl : integral_constant_impl<bool, __is_trivially_
 {
 };
 
+// Moving T to another address and ending the source's lifetime is equivalent to copying its bytes
+template <typename T>
+struct is_trivially_relocatable_impl : integral_constant_impl<bool, __is_trivially_copyable(T)>
+{
+};
+
 template <typename T>
 struct is_abstract_impl : integral_constant_impl<bool, __is_abstract(T)>
 {
@@ -675,6 +682,14 @@ struct is_trivially_copyable : detail::is_trivially_copyable_impl<T>
 {
 };
 
+// Trivially copyable types are trivially relocatable. Other types opt in with a specialization, when neither the move
+// constructor nor the destructor depends on the object's address (no self pointers, no registration by address):
+//   template <> struct erturk::meta::is_trivially_relocatable<MyType> : erturk::detail::true_type {};
+template <typename T>
+struct is_trivially_relocatable : detail::is_trivially_relocatable_impl<T>
+{
+};
+
 template <typename T>
 struct is_trivially_assignable : detail::is_trivially_assignable_impl<T>
 {
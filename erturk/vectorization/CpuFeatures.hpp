@@ -0,0 +1,220 @@
+#ifndef ERTURK_CPU_FEATURES_H
+#define ERTURK_CPU_FEATURES_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define ERTURK_SIMD_X86
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#define ERTURK_SIMD_NEON
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+/*
+Runtime CPU feature detection for SIMD dispatch.
+
+Detection runs once (first call of features()) and is cached for the lifetime of the process, so one binary can pick the
+widest supported kernel on every host of a mixed fleet:
+- x86/x86_64 : cpuid leaves 1 and 7, plus xgetbv to ensure the OS saves YMM/ZMM state on context switch.
+- aarch64    : AT_HWCAP from the auxiliary vector (NEON/ASIMD is mandatory on aarch64, auxv is only a sanity check).
+
+Kernels for an instruction set wider than the compile flags are built with target attributes (ERTURK_TARGET_*), so no
+-mavx2/-mavx512f flag is needed at compile time.
+
+The selected level can be capped (never raised) with the environment variable ERTURK_SIMD_ISA=scalar|sse2|avx2|avx512
+|neon, which helps to reproduce results of an older host.
+*/
+
+#if defined(ERTURK_SIMD_X86)
+#define ERTURK_TARGET_SSE2 __attribute__((target("sse2")))
+#define ERTURK_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define ERTURK_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,avx2,fma")))
+#endif
+
+namespace erturk::simd::cpu
+{
+
+enum class InstructionSet : unsigned char
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512,
+    NEON
+};
+
+struct Features
+{
+    bool sse2{false};
+    bool sse41{false};
+    bool avx{false};
+    bool avx2{false};
+    bool fma{false};
+    bool bmi2{false};
+    bool avx512f{false};
+    bool avx512vl{false};
+    bool avx512bw{false};
+    bool avx512dq{false};
+    bool neon{false};
+};
+
+namespace detail
+{
+
+#if defined(ERTURK_SIMD_X86)
+inline uint64_t read_xcr0() noexcept
+{
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+#endif
+
+inline Features detect_features() noexcept
+{
+    Features features{};
+
+#if defined(ERTURK_SIMD_X86)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return features;
+    }
+
+    features.sse2 = (edx & bit_SSE2) != 0;
+    features.sse41 = (ecx & bit_SSE4_1) != 0;
+
+    // CPU support is not enough, OS must also preserve the wide registers (XCR0)
+    const bool os_xsave = (ecx & bit_OSXSAVE) != 0;
+    const uint64_t xcr0 = os_xsave ? read_xcr0() : 0;
+    const bool os_ymm = (xcr0 & 0x6) == 0x6;     // XMM | YMM
+    const bool os_zmm = (xcr0 & 0xE6) == 0xE6;  // XMM | YMM | OPMASK | ZMM_Hi256 | Hi16_ZMM
+
+    features.avx = os_ymm && (ecx & bit_AVX) != 0;
+    features.fma = features.avx && (ecx & bit_FMA) != 0;
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0)
+    {
+        features.avx2 = features.avx && (ebx & bit_AVX2) != 0;
+        features.bmi2 = (ebx & bit_BMI2) != 0;
+        features.avx512f = os_zmm && (ebx & bit_AVX512F) != 0;
+        features.avx512vl = features.avx512f && (ebx & bit_AVX512VL) != 0;
+        features.avx512bw = features.avx512f && (ebx & bit_AVX512BW) != 0;
+        features.avx512dq = features.avx512f && (ebx & bit_AVX512DQ) != 0;
+    }
+#elif defined(ERTURK_SIMD_NEON)
+#if defined(__linux__) && defined(AT_HWCAP)
+#if defined(__aarch64__)
+    constexpr unsigned long HWCAP_ASIMD_BIT = 1UL << 1;
+    features.neon = (getauxval(AT_HWCAP) & HWCAP_ASIMD_BIT) != 0;
+#else
+    constexpr unsigned long HWCAP_NEON_BIT = 1UL << 12;
+    features.neon = (getauxval(AT_HWCAP) & HWCAP_NEON_BIT) != 0;
+#endif
+#else
+    features.neon = true;
+#endif
+#endif
+
+    return features;
+}
+
+inline InstructionSet widest_instruction_set(const Features& features) noexcept
+{
+#if defined(ERTURK_SIMD_X86)
+    if (features.avx512f && features.avx512vl && features.avx512bw && features.avx512dq && features.fma)
+    {
+        return InstructionSet::AVX512;
+    }
+    if (features.avx2 && features.fma)
+    {
+        return InstructionSet::AVX2;
+    }
+    if (features.sse2)
+    {
+        return InstructionSet::SSE2;
+    }
+#elif defined(ERTURK_SIMD_NEON)
+    if (features.neon)
+    {
+        return InstructionSet::NEON;
+    }
+#endif
+    return InstructionSet::Scalar;
+}
+
+// Lower "detected" to the level requested with ERTURK_SIMD_ISA, unknown values are ignored
+inline InstructionSet apply_environment_cap(const InstructionSet detected) noexcept
+{
+    const char* requested = std::getenv("ERTURK_SIMD_ISA");
+    if (requested == nullptr)
+    {
+        return detected;
+    }
+
+    if (std::strcmp(requested, "scalar") == 0)
+    {
+        return InstructionSet::Scalar;
+    }
+    if (detected == InstructionSet::NEON)
+    {
+        return detected;
+    }
+    if (std::strcmp(requested, "sse2") == 0 && detected >= InstructionSet::SSE2)
+    {
+        return InstructionSet::SSE2;
+    }
+    if (std::strcmp(requested, "avx2") == 0 && detected >= InstructionSet::AVX2)
+    {
+        return InstructionSet::AVX2;
+    }
+    return detected;
+}
+
+}  // namespace detail
+
+inline const Features& features() noexcept
+{
+    static const Features detected = detail::detect_features();
+    return detected;
+}
+
+// Widest instruction set that is usable on this host, resolved once
+inline InstructionSet instruction_set() noexcept
+{
+    static const InstructionSet selected =
+        detail::apply_environment_cap(detail::widest_instruction_set(features()));
+    return selected;
+}
+
+inline const char* instruction_set_name(const InstructionSet instruction_set) noexcept
+{
+    switch (instruction_set)
+    {
+        case InstructionSet::SSE2:
+            return "sse2";
+        case InstructionSet::AVX2:
+            return "avx2";
+        case InstructionSet::AVX512:
+            return "avx512";
+        case InstructionSet::NEON:
+            return "neon";
+        case InstructionSet::Scalar:
+        default:
+            return "scalar";
+    }
+}
+
+}  // namespace erturk::simd::cpu
+
+#endif  // ERTURK_CPU_FEATURES_H
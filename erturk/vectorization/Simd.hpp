@@ -1,7 +1,11 @@
 #ifndef ERTURK_SIMD_H
 #define ERTURK_SIMD_H
 
-#if defined(__x86_64__) || defined(__i386__)
+#include "SimdDispatch.hpp"
+#include "SimdReduce.hpp"
+#include "SimdSort.hpp"
+
+#if defined(ERTURK_SIMD_X86)
 
 #include <immintrin.h>  // AVX
 #include <xmmintrin.h>  // SSE
@@ -10,8 +14,10 @@
 Data Alignment: For optimal performance, ensure that your data is aligned on 16-byte (for SSE) or 32-byte (for AVX)
 boundaries.
 
-Compiler Flags: Use appropriate compiler flags to enable SIMD instructions, like -msse, -msse2, -mavx, etc., when
-compiling your code. g++ -mavx -msse -o simd_example simd_example.cpp
+Instruction set specific kernels, thin wrappers over the kernel family of SimdKernels.hpp: any n is safe and aligned
+loads are used when the buffers allow it. AVX kernels are compiled with a target attribute, so no -mavx flag is needed,
+but the caller must check cpu::features() first. Prefer the ISA agnostic functions of SimdDispatch.hpp and
+SimdReduce.hpp (addFloats, dotProduct, ...), they pick the widest kernel of the running CPU.
 */
 namespace erturk
 {
@@ -20,202 +26,131 @@ namespace simd
 
 inline void addFloatsSSE(float* a, float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 aVec = _mm_loadu_ps(&a[i]);
-        __m128 bVec = _mm_loadu_ps(&b[i]);
-        __m128 resultVec = _mm_add_ps(aVec, bVec);
-        _mm_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::sse2_binary<op::Add>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void addFloatsAVX(float* a, float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 8)
+    if (n <= 0)
     {
-        __m256 aVec = _mm256_loadu_ps(&a[i]);
-        __m256 bVec = _mm256_loadu_ps(&b[i]);
-        __m256 resultVec = _mm256_add_ps(aVec, bVec);
-        _mm256_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::avx2_binary<op::Add>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void multiplyFloatsSSE(const float* a, const float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 aVec = _mm_loadu_ps(&a[i]);
-        __m128 bVec = _mm_loadu_ps(&b[i]);
-        __m128 resultVec = _mm_mul_ps(aVec, bVec);
-        _mm_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::sse2_binary<op::Multiply>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void subtractFloatsSSE(float* a, float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 aVec = _mm_loadu_ps(&a[i]);
-        __m128 bVec = _mm_loadu_ps(&b[i]);
-        __m128 resultVec = _mm_sub_ps(aVec, bVec);
-        _mm_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::sse2_binary<op::Subtract>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void subtractFloatsAVX(float* a, float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 8)
+    if (n <= 0)
     {
-        __m256 aVec = _mm256_loadu_ps(&a[i]);
-        __m256 bVec = _mm256_loadu_ps(&b[i]);
-        __m256 resultVec = _mm256_sub_ps(aVec, bVec);
-        _mm256_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::avx2_binary<op::Subtract>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void divideFloatsSSE(float* a, float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 aVec = _mm_loadu_ps(&a[i]);
-        __m128 bVec = _mm_loadu_ps(&b[i]);
-        __m128 resultVec = _mm_div_ps(aVec, bVec);
-        _mm_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::sse2_binary<op::Divide>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void reciprocalFloatsAVX(float* a, float* result, int n)
 {
-    for (int i = 0; i < n; i += 8)
+    if (n <= 0)
     {
-        __m256 aVec = _mm256_loadu_ps(&a[i]);
-        __m256 resultVec = _mm256_rcp_ps(aVec);
-        _mm256_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::avx2_unary<op::Reciprocal>(a, result, static_cast<size_t>(n));
 }
 
 inline void minElementsSSE(const float* a, const float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 aVec = _mm_loadu_ps(&a[i]);
-        __m128 bVec = _mm_loadu_ps(&b[i]);
-        __m128 minVec = _mm_min_ps(aVec, bVec);
-        _mm_storeu_ps(&result[i], minVec);
+        return;
     }
+    dispatch::sse2_binary<op::Min>(a, b, result, static_cast<size_t>(n));
 }
 
 inline float dotProductAVX(const float* a, const float* b, int n)
 {
-    __m256 sumVec = _mm256_setzero_ps();
-    for (int i = 0; i < n; i += 8)
-    {
-        __m256 aVec = _mm256_loadu_ps(&a[i]);
-        __m256 bVec = _mm256_loadu_ps(&b[i]);
-        __m256 multVec = _mm256_mul_ps(aVec, bVec);
-        sumVec = _mm256_add_ps(sumVec, multVec);
-    }
-    float sumArray[8];
-    _mm256_storeu_ps(sumArray, sumVec);
-    float dotProduct = 0;
-    for (int i = 0; i < 8; ++i)
+    if (n <= 0)
     {
-        dotProduct += sumArray[i];
+        return 0.0f;
     }
-    return dotProduct;
+    return reduction::Avx2Reduction::accumulate<reduction::Term::Dot, false>(a, b, 0.0f, static_cast<size_t>(n));
 }
 
 inline float dotProductSSE(const float* a, const float* b, const int n)
 {
-    __m128 sum = _mm_setzero_ps();
-
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 a_chunk = _mm_loadu_ps(&a[i]);
-        __m128 b_chunk = _mm_loadu_ps(&b[i]);
-        __m128 prod = _mm_mul_ps(a_chunk, b_chunk);
-        sum = _mm_add_ps(sum, prod);
+        return 0.0f;
     }
-
-    float result[4];
-    _mm_storeu_ps(result, sum);
-    return result[0] + result[1] + result[2] + result[3];
+    return reduction::Sse2Reduction::accumulate<reduction::Term::Dot, false>(a, b, 0.0f, static_cast<size_t>(n));
 }
 
 inline void addVectorsSSE(const float* a, const float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 4)
+    if (n <= 0)
     {
-        __m128 aVec = _mm_loadu_ps(&a[i]);
-        __m128 bVec = _mm_loadu_ps(&b[i]);
-        __m128 resultVec = _mm_add_ps(aVec, bVec);
-        _mm_storeu_ps(&result[i], resultVec);
+        return;
     }
+    dispatch::sse2_binary<op::Add>(a, b, result, static_cast<size_t>(n));
 }
 
 inline void maxElementsAVX(const float* a, const float* b, float* result, int n)
 {
-    for (int i = 0; i < n; i += 8)
+    if (n <= 0)
     {
-        __m256 aVec = _mm256_loadu_ps(&a[i]);
-        __m256 bVec = _mm256_loadu_ps(&b[i]);
-        __m256 maxVec = _mm256_max_ps(aVec, bVec);
-        _mm256_storeu_ps(&result[i], maxVec);
+        return;
     }
+    dispatch::avx2_binary<op::Max>(a, b, result, static_cast<size_t>(n));
 }
 
-void simdChunkedSort(float* data, size_t size)
+// Both names are kept for existing callers, they now fully sort ascending, see SimdSort.hpp
+inline void simdChunkedSort(float* data, size_t size)
 {
-    // Ensure we have at least 8 floats
-    if (size < 8) return;
-
-    // Iterate over the array in steps of 8 elements
-    for (size_t i = 0; i < size - 4; i += 4)
-    {
-        // Load two adjacent blocks of 4 floats
-        __m128 a = _mm_loadu_ps(&data[i]);
-        __m128 b = _mm_loadu_ps(&data[i + 4]);
-
-        // Sort the blocks
-        __m128 min = _mm_min_ps(a, b);
-        __m128 max = _mm_max_ps(a, b);
-
-        // Store the sorted blocks back
-        _mm_storeu_ps(&data[i], min);
-        _mm_storeu_ps(&data[i + 4], max);
-    }
+    sortFloats(data, size);
 }
 
 inline void simdBubbleSort(float* data, size_t size)
 {
-    bool swapped;
-    do
-    {
-        swapped = false;
-        for (size_t i = 0; i < size - 4; i += 4)
-        {
-            __m128 a = _mm_loadu_ps(&data[i]);
-            __m128 b = _mm_loadu_ps(&data[i + 4]);
-
-            __m128 min = _mm_min_ps(a, b);
-            __m128 max = _mm_max_ps(a, b);
-
-            _mm_storeu_ps(&data[i], min);
-            _mm_storeu_ps(&data[i + 4], max);
-
-            if (!_mm_comieq_ss(a, min))
-            {
-                swapped = true;
-            }
-        }
-    } while (swapped);
+    sortFloats(data, size);
 }
 
-void matrixMultiplySSE(float* a, float* b, float* result, int rows, int cols)
+// result (rows x cols) = a (rows x cols) * b (cols x cols), row-major; any cols. For large or non square products use
+// linear_algebra::sgemm, which is cache blocked and multithreaded.
+inline void matrixMultiplySSE(float* a, float* b, float* result, int rows, int cols)
 {
     for (int i = 0; i < rows; i++)
     {
-        for (int j = 0; j < cols; j += 4)
+        int j = 0;
+        for (; j + 4 <= cols; j += 4)
         {
             __m128 sum = _mm_setzero_ps();
             for (int k = 0; k < cols; k++)
@@ -226,14 +161,21 @@ void matrixMultiplySSE(float* a, float* b, float* result, int rows, int cols)
             }
             _mm_storeu_ps(&result[i * cols + j], sum);
         }
+        for (; j < cols; j++)
+        {
+            float sum = 0.0f;
+            for (int k = 0; k < cols; k++)
+            {
+                sum += a[i * cols + k] * b[k * cols + j];
+            }
+            result[i * cols + j] = sum;
+        }
     }
 }
 
 }  // namespace simd
 }  // namespace erturk
 
-#else
-#error "This SIMD functionality is only supported on x86 and x86_64 architectures."
-#endif
+#endif  // ERTURK_SIMD_X86
 
 #endif  // ERTURK_SIMD_H
@@ -0,0 +1,201 @@
+#ifndef ERTURK_SIMD_DISPATCH_H
+#define ERTURK_SIMD_DISPATCH_H
+
+#include "CpuFeatures.hpp"
+#include "SimdKernels.hpp"
+#include "SimdTraits.hpp"
+#include <cstddef>
+
+/*
+Runtime dispatch of float kernels.
+
+The first call resolves a table of function pointers for the widest instruction set reported by cpu::instruction_set()
+(AVX-512 > AVX2 > SSE2 on x86, NEON on ARM, scalar everywhere else). After that, every call is one indirect call
+through a read-only table, no feature test on the hot path.
+
+Function pointers are used instead of ifunc resolvers: this library is header-only and ifunc needs an exported
+definition in a single translation unit, pointers also work on non-ELF platforms.
+*/
+namespace erturk::simd
+{
+
+using BinaryKernel = void (*)(const float*, const float*, float*, size_t);
+using UnaryKernel = void (*)(const float*, float*, size_t);
+
+struct KernelTable
+{
+    BinaryKernel add{nullptr};
+    BinaryKernel subtract{nullptr};
+    BinaryKernel multiply{nullptr};
+    BinaryKernel divide{nullptr};
+    BinaryKernel min{nullptr};
+    BinaryKernel max{nullptr};
+    UnaryKernel reciprocal{nullptr};
+    cpu::InstructionSet instruction_set{cpu::InstructionSet::Scalar};
+};
+
+namespace dispatch
+{
+
+// Entry points are flattened, so the generic kernel and traits collapse into one function compiled for the target.
+
+template <class Op>
+inline void scalar_binary(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernels::elementwise<traits::ScalarTraits, Op>(a, b, result, n);
+}
+
+template <class Op>
+inline void scalar_unary(const float* a, float* result, const size_t n) noexcept
+{
+    kernels::elementwise<traits::ScalarTraits, Op>(a, result, n);
+}
+
+#if defined(ERTURK_SIMD_X86)
+
+template <class Op>
+ERTURK_TARGET_SSE2 __attribute__((flatten)) inline void sse2_binary(const float* a, const float* b, float* result,
+                                                                     const size_t n) noexcept
+{
+    kernels::elementwise<traits::Sse2Traits, Op>(a, b, result, n);
+}
+
+template <class Op>
+ERTURK_TARGET_SSE2 __attribute__((flatten)) inline void sse2_unary(const float* a, float* result,
+                                                                    const size_t n) noexcept
+{
+    kernels::elementwise<traits::Sse2Traits, Op>(a, result, n);
+}
+
+template <class Op>
+ERTURK_TARGET_AVX2 __attribute__((flatten)) inline void avx2_binary(const float* a, const float* b, float* result,
+                                                                     const size_t n) noexcept
+{
+    kernels::elementwise<traits::Avx2Traits, Op>(a, b, result, n);
+}
+
+template <class Op>
+ERTURK_TARGET_AVX2 __attribute__((flatten)) inline void avx2_unary(const float* a, float* result,
+                                                                    const size_t n) noexcept
+{
+    kernels::elementwise<traits::Avx2Traits, Op>(a, result, n);
+}
+
+template <class Op>
+ERTURK_TARGET_AVX512 __attribute__((flatten)) inline void avx512_binary(const float* a, const float* b,
+                                                                         float* result, const size_t n) noexcept
+{
+    kernels::elementwise<traits::Avx512Traits, Op>(a, b, result, n);
+}
+
+template <class Op>
+ERTURK_TARGET_AVX512 __attribute__((flatten)) inline void avx512_unary(const float* a, float* result,
+                                                                        const size_t n) noexcept
+{
+    kernels::elementwise<traits::Avx512Traits, Op>(a, result, n);
+}
+
+#elif defined(ERTURK_SIMD_NEON)
+
+template <class Op>
+__attribute__((flatten)) inline void neon_binary(const float* a, const float* b, float* result,
+                                                 const size_t n) noexcept
+{
+    kernels::elementwise<traits::NeonTraits, Op>(a, b, result, n);
+}
+
+template <class Op>
+__attribute__((flatten)) inline void neon_unary(const float* a, float* result, const size_t n) noexcept
+{
+    kernels::elementwise<traits::NeonTraits, Op>(a, result, n);
+}
+
+#endif
+
+#define ERTURK_SIMD_FILL_KERNEL_TABLE(table, prefix, Traits)            \
+    table.add = prefix##_binary<op::Add>;                             \
+    table.subtract = prefix##_binary<op::Subtract>;                   \
+    table.multiply = prefix##_binary<op::Multiply>;                   \
+    table.divide = prefix##_binary<op::Divide>;                       \
+    table.min = prefix##_binary<op::Min>;                             \
+    table.max = prefix##_binary<op::Max>;                             \
+    table.reciprocal = prefix##_unary<op::Reciprocal>;                \
+    table.instruction_set = Traits::INSTRUCTION_SET;
+
+inline KernelTable make_kernel_table(const cpu::InstructionSet instruction_set) noexcept
+{
+    KernelTable table{};
+
+    switch (instruction_set)
+    {
+#if defined(ERTURK_SIMD_X86)
+        case cpu::InstructionSet::AVX512:
+            ERTURK_SIMD_FILL_KERNEL_TABLE(table, avx512, traits::Avx512Traits)
+            return table;
+        case cpu::InstructionSet::AVX2:
+            ERTURK_SIMD_FILL_KERNEL_TABLE(table, avx2, traits::Avx2Traits)
+            return table;
+        case cpu::InstructionSet::SSE2:
+            ERTURK_SIMD_FILL_KERNEL_TABLE(table, sse2, traits::Sse2Traits)
+            return table;
+#elif defined(ERTURK_SIMD_NEON)
+        case cpu::InstructionSet::NEON:
+            ERTURK_SIMD_FILL_KERNEL_TABLE(table, neon, traits::NeonTraits)
+            return table;
+#endif
+        case cpu::InstructionSet::Scalar:
+        default:
+            ERTURK_SIMD_FILL_KERNEL_TABLE(table, scalar, traits::ScalarTraits)
+            return table;
+    }
+}
+
+#undef ERTURK_SIMD_FILL_KERNEL_TABLE
+
+}  // namespace dispatch
+
+// Resolved once, on first use
+inline const KernelTable& kernel_table() noexcept
+{
+    static const KernelTable table = dispatch::make_kernel_table(cpu::instruction_set());
+    return table;
+}
+
+inline void addFloats(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernel_table().add(a, b, result, n);
+}
+
+inline void subtractFloats(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernel_table().subtract(a, b, result, n);
+}
+
+inline void multiplyFloats(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernel_table().multiply(a, b, result, n);
+}
+
+inline void divideFloats(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernel_table().divide(a, b, result, n);
+}
+
+inline void minElements(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernel_table().min(a, b, result, n);
+}
+
+inline void maxElements(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    kernel_table().max(a, b, result, n);
+}
+
+inline void reciprocalFloats(const float* a, float* result, const size_t n) noexcept
+{
+    kernel_table().reciprocal(a, result, n);
+}
+
+}  // namespace erturk::simd
+
+#endif  // ERTURK_SIMD_DISPATCH_H
@@ -0,0 +1,116 @@
+#ifndef ERTURK_SIMD_KERNELS_H
+#define ERTURK_SIMD_KERNELS_H
+
+#include "../memory/Alignment.hpp"
+#include "SimdTraits.hpp"
+#include <cstddef>
+
+/*
+Instruction set independent float kernels, one family templated over the operation (op::*) and the vector width
+(traits::*Traits).
+
+- Any length is safe: n % WIDTH remaining elements are finished with a masked vector (AVX2, AVX-512) or with the scalar
+  operation, nothing is read or written past a + n, b + n, result + n.
+- Aligned loads/stores are selected when every pointer is proven aligned to Traits::ALIGNMENT, e.g. buffers of
+  AlignedSystemAllocator<float, 32> on AVX2. Otherwise the unaligned variants are used, no padding copy is made.
+*/
+namespace erturk::simd::kernels
+{
+
+namespace detail
+{
+
+template <class Traits, class Op, bool ALIGNED>
+inline size_t elementwise_body(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    size_t idx = 0;
+    for (; idx + Traits::WIDTH <= n; idx += Traits::WIDTH)
+    {
+        Traits::template binary<Op, ALIGNED>(a + idx, b + idx, result + idx);
+    }
+    return idx;
+}
+
+template <class Traits, class Op, bool ALIGNED>
+inline size_t elementwise_body(const float* a, float* result, const size_t n) noexcept
+{
+    size_t idx = 0;
+    for (; idx + Traits::WIDTH <= n; idx += Traits::WIDTH)
+    {
+        Traits::template unary<Op, ALIGNED>(a + idx, result + idx);
+    }
+    return idx;
+}
+
+template <class Traits>
+inline bool is_vector_aligned(const void* ptr) noexcept
+{
+    return memory::alignment::isAddressAligned(ptr, Traits::ALIGNMENT);
+}
+
+}  // namespace detail
+
+// result[i] = Op(a[i], b[i])
+template <class Traits, class Op>
+inline void elementwise(const float* a, const float* b, float* result, const size_t n) noexcept
+{
+    size_t idx = 0;
+    if constexpr (Traits::WIDTH > 1)
+    {
+        const bool aligned = detail::is_vector_aligned<Traits>(a) && detail::is_vector_aligned<Traits>(b) &&
+                             detail::is_vector_aligned<Traits>(result);
+        idx = aligned ? detail::elementwise_body<Traits, Op, true>(a, b, result, n)
+                      : detail::elementwise_body<Traits, Op, false>(a, b, result, n);
+    }
+
+    if (idx == n)
+    {
+        return;
+    }
+
+    if constexpr (Traits::MASKED_TAIL)
+    {
+        Traits::template binary_tail<Op>(a + idx, b + idx, result + idx, n - idx);
+    }
+    else
+    {
+        for (; idx < n; idx++)
+        {
+            result[idx] = Op::scalar(a[idx], b[idx]);
+        }
+    }
+}
+
+// result[i] = Op(a[i])
+template <class Traits, class Op>
+inline void elementwise(const float* a, float* result, const size_t n) noexcept
+{
+    size_t idx = 0;
+    if constexpr (Traits::WIDTH > 1)
+    {
+        const bool aligned = detail::is_vector_aligned<Traits>(a) && detail::is_vector_aligned<Traits>(result);
+        idx = aligned ? detail::elementwise_body<Traits, Op, true>(a, result, n)
+                      : detail::elementwise_body<Traits, Op, false>(a, result, n);
+    }
+
+    if (idx == n)
+    {
+        return;
+    }
+
+    if constexpr (Traits::MASKED_TAIL)
+    {
+        Traits::template unary_tail<Op>(a + idx, result + idx, n - idx);
+    }
+    else
+    {
+        for (; idx < n; idx++)
+        {
+            result[idx] = Op::scalar(a[idx]);
+        }
+    }
+}
+
+}  // namespace erturk::simd::kernels
+
+#endif  // ERTURK_SIMD_KERNELS_H
@@ -0,0 +1,966 @@
+#ifndef ERTURK_SIMD_REDUCE_H
+#define ERTURK_SIMD_REDUCE_H
+
+#include "CpuFeatures.hpp"
+#include "SimdTraits.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#if defined(ERTURK_SIMD_X86)
+#include <immintrin.h>
+#elif defined(ERTURK_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+Float reductions: sum, dot, L2 norm, min/max, argmin/argmax, mean/variance.
+
+Accumulation runs on several independent vector accumulators (8 for AVX2/AVX-512, 4 for SSE2/NEON), so consecutive
+FMAs do not wait on each other, and ends with an in-register horizontal reduce. Tails are handled with masked or zero
+padded vectors, nothing is read past n.
+
+Summation modes:
+- Fast     : plain (FMA) accumulation, error grows with n / (accumulators * width).
+- Kahan    : compensated summation per lane, error independent of n. Must not be built with -ffast-math.
+- Pairwise : the input is halved recursively down to PAIRWISE_BLOCK_ elements summed with the fast kernel.
+
+min/max ignore NaN elements and return +inf/-inf when nothing is ordered, argmin/argmax return the first index of the
+extreme value, or n when there is none.
+*/
+namespace erturk::simd
+{
+
+enum class Summation : unsigned char
+{
+    Fast,
+    Kahan,
+    Pairwise
+};
+
+struct MeanVariance
+{
+    float mean;
+    float variance;  // population variance
+};
+
+namespace reduction
+{
+
+// Accumulated term of element i
+enum class Term : unsigned char
+{
+    Sum,               // a[i]
+    Dot,               // a[i] * b[i]
+    SquaredDeviation,  // (a[i] - shift)^2
+};
+
+inline constexpr size_t TERM_COUNT_ = 3;
+inline constexpr size_t PAIRWISE_BLOCK_ = 1024;
+
+using AccumulateKernel = float (*)(const float* a, const float* b, float shift, size_t n);
+using ExtremeKernel = float (*)(const float* a, size_t n);
+using FindKernel = size_t (*)(const float* a, size_t n, float value);
+
+// ************************************************* Scalar *************************************************
+
+struct ScalarReduction
+{
+    static constexpr size_t ACCUMULATORS = 4;
+
+    template <Term TERM>
+    static float term(const float* a, const float* b, const size_t idx, const float shift) noexcept
+    {
+        if constexpr (TERM == Term::Sum)
+        {
+            return a[idx];
+        }
+        else if constexpr (TERM == Term::Dot)
+        {
+            return a[idx] * b[idx];
+        }
+        else
+        {
+            const float deviation = a[idx] - shift;
+            return deviation * deviation;
+        }
+    }
+
+    template <bool COMPENSATED>
+    static void add(float& sum, float& compensation, const float value) noexcept
+    {
+        if constexpr (COMPENSATED)
+        {
+            const float corrected = value - compensation;
+            const float total = sum + corrected;
+            compensation = (total - sum) - corrected;
+            sum = total;
+        }
+        else
+        {
+            sum += value;
+        }
+    }
+
+    template <Term TERM, bool COMPENSATED>
+    static float accumulate(const float* a, const float* b, const float shift, const size_t n) noexcept
+    {
+        float sum[ACCUMULATORS] = {};
+        float compensation[ACCUMULATORS] = {};
+
+        size_t idx = 0;
+        for (; idx + ACCUMULATORS <= n; idx += ACCUMULATORS)
+        {
+            for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+            {
+                add<COMPENSATED>(sum[acc], compensation[acc], term<TERM>(a, b, idx + acc, shift));
+            }
+        }
+        for (; idx < n; idx++)
+        {
+            add<COMPENSATED>(sum[0], compensation[0], term<TERM>(a, b, idx, shift));
+        }
+
+        float total = 0.0f;
+        for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+        {
+            total += sum[acc] - compensation[acc];
+        }
+        return total;
+    }
+
+    // Candidate first: a NaN candidate never replaces the accumulator
+    template <bool MAXIMUM>
+    static float pick(const float candidate, const float current) noexcept
+    {
+        if constexpr (MAXIMUM)
+        {
+            return candidate > current ? candidate : current;
+        }
+        return candidate < current ? candidate : current;
+    }
+
+    template <bool MAXIMUM>
+    static float extreme(const float* a, const size_t n) noexcept
+    {
+        constexpr float IDENTITY = MAXIMUM ? -std::numeric_limits<float>::infinity()
+                                           : std::numeric_limits<float>::infinity();
+        float current[ACCUMULATORS] = {IDENTITY, IDENTITY, IDENTITY, IDENTITY};
+
+        size_t idx = 0;
+        for (; idx + ACCUMULATORS <= n; idx += ACCUMULATORS)
+        {
+            for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+            {
+                current[acc] = pick<MAXIMUM>(a[idx + acc], current[acc]);
+            }
+        }
+        for (; idx < n; idx++)
+        {
+            current[0] = pick<MAXIMUM>(a[idx], current[0]);
+        }
+        return pick<MAXIMUM>(pick<MAXIMUM>(current[0], current[1]), pick<MAXIMUM>(current[2], current[3]));
+    }
+
+    static size_t find(const float* a, const size_t n, const float value) noexcept
+    {
+        for (size_t idx = 0; idx < n; idx++)
+        {
+            if (a[idx] == value)
+            {
+                return idx;
+            }
+        }
+        return n;
+    }
+};
+
+#if defined(ERTURK_SIMD_X86)
+
+// ************************************************* SSE2 *************************************************
+
+struct Sse2Reduction
+{
+    static constexpr size_t WIDTH = 4;
+    static constexpr size_t ACCUMULATORS = 4;
+
+    template <Term TERM, bool COMPENSATED>
+    ERTURK_TARGET_SSE2 static void step(__m128& sum, __m128& compensation, const __m128 x, const __m128 y,
+                                        const __m128 shift) noexcept
+    {
+        __m128 value = x;
+        if constexpr (TERM == Term::Dot)
+        {
+            value = _mm_mul_ps(x, y);
+        }
+        else if constexpr (TERM == Term::SquaredDeviation)
+        {
+            const __m128 deviation = _mm_sub_ps(x, shift);
+            value = _mm_mul_ps(deviation, deviation);
+        }
+
+        if constexpr (COMPENSATED)
+        {
+            const __m128 corrected = _mm_sub_ps(value, compensation);
+            const __m128 total = _mm_add_ps(sum, corrected);
+            compensation = _mm_sub_ps(_mm_sub_ps(total, sum), corrected);
+            sum = total;
+        }
+        else
+        {
+            sum = _mm_add_ps(sum, value);
+        }
+    }
+
+    template <Term TERM, bool COMPENSATED>
+    ERTURK_TARGET_SSE2 static float accumulate(const float* a, const float* b, const float shift,
+                                               const size_t n) noexcept
+    {
+        __m128 sum[ACCUMULATORS];
+        __m128 compensation[ACCUMULATORS];
+        for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+        {
+            sum[acc] = _mm_setzero_ps();
+            compensation[acc] = _mm_setzero_ps();
+        }
+        const __m128 shift_v = _mm_set1_ps(shift);
+
+        size_t idx = 0;
+        for (; idx + ACCUMULATORS * WIDTH <= n; idx += ACCUMULATORS * WIDTH)
+        {
+            for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+            {
+                const size_t offset = idx + acc * WIDTH;
+                const __m128 x = _mm_loadu_ps(a + offset);
+                const __m128 y = TERM == Term::Dot ? _mm_loadu_ps(b + offset) : x;
+                step<TERM, COMPENSATED>(sum[acc], compensation[acc], x, y, shift_v);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            const __m128 x = _mm_loadu_ps(a + idx);
+            const __m128 y = TERM == Term::Dot ? _mm_loadu_ps(b + idx) : x;
+            step<TERM, COMPENSATED>(sum[0], compensation[0], x, y, shift_v);
+        }
+
+        if (idx < n)
+        {
+            // Zero padded copy, padding lanes are cleared after the term (a deviation of 0 is not 0)
+            const size_t count = n - idx;
+            alignas(16) float x_tail[WIDTH] = {};
+            alignas(16) float y_tail[WIDTH] = {};
+            std::memcpy(x_tail, a + idx, count * sizeof(float));
+            if constexpr (TERM == Term::Dot)
+            {
+                std::memcpy(y_tail, b + idx, count * sizeof(float));
+            }
+
+            __m128 partial_sum = _mm_setzero_ps();
+            __m128 partial_compensation = _mm_setzero_ps();
+            step<TERM, false>(partial_sum, partial_compensation, _mm_load_ps(x_tail), _mm_load_ps(y_tail), shift_v);
+            const __m128 mask = _mm_castsi128_ps(
+                _mm_cmpgt_epi32(_mm_set1_epi32(static_cast<int>(count)), _mm_setr_epi32(0, 1, 2, 3)));
+            step<Term::Sum, COMPENSATED>(sum[0], compensation[0], _mm_and_ps(partial_sum, mask), shift_v, shift_v);
+        }
+
+        __m128 total = _mm_sub_ps(sum[0], compensation[0]);
+        for (size_t acc = 1; acc < ACCUMULATORS; acc++)
+        {
+            total = _mm_add_ps(total, _mm_sub_ps(sum[acc], compensation[acc]));
+        }
+        return traits::Sse2Traits::reduce_add(total);
+    }
+
+    template <bool MAXIMUM>
+    ERTURK_TARGET_SSE2 static __m128 pick(const __m128 candidate, const __m128 current) noexcept
+    {
+        if constexpr (MAXIMUM)
+        {
+            return _mm_max_ps(candidate, current);
+        }
+        return _mm_min_ps(candidate, current);
+    }
+
+    template <bool MAXIMUM>
+    ERTURK_TARGET_SSE2 static float extreme(const float* a, const size_t n) noexcept
+    {
+        const __m128 identity = _mm_set1_ps(MAXIMUM ? -std::numeric_limits<float>::infinity()
+                                                    : std::numeric_limits<float>::infinity());
+        __m128 current[ACCUMULATORS] = {identity, identity, identity, identity};
+
+        size_t idx = 0;
+        for (; idx + ACCUMULATORS * WIDTH <= n; idx += ACCUMULATORS * WIDTH)
+        {
+            for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+            {
+                current[acc] = pick<MAXIMUM>(_mm_loadu_ps(a + idx + acc * WIDTH), current[acc]);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            current[0] = pick<MAXIMUM>(_mm_loadu_ps(a + idx), current[0]);
+        }
+
+        __m128 v = pick<MAXIMUM>(pick<MAXIMUM>(current[0], current[1]), pick<MAXIMUM>(current[2], current[3]));
+        v = pick<MAXIMUM>(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)), v);
+        v = pick<MAXIMUM>(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)), v);
+
+        float result = _mm_cvtss_f32(v);
+        for (; idx < n; idx++)
+        {
+            result = ScalarReduction::pick<MAXIMUM>(a[idx], result);
+        }
+        return result;
+    }
+
+    ERTURK_TARGET_SSE2 static size_t find(const float* a, const size_t n, const float value) noexcept
+    {
+        const __m128 target = _mm_set1_ps(value);
+        size_t idx = 0;
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a + idx), target));
+            if (mask != 0)
+            {
+                return idx + static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+            }
+        }
+        const size_t found = ScalarReduction::find(a + idx, n - idx, value);
+        return idx + found;
+    }
+};
+
+// ************************************************* AVX2 *************************************************
+
+struct Avx2Reduction
+{
+    static constexpr size_t WIDTH = 8;
+
+    // Kahan needs two registers per accumulator, 4 of them keep the loop free of spills
+    template <bool COMPENSATED>
+    static constexpr size_t ACCUMULATORS = COMPENSATED ? 4 : 8;
+
+    template <Term TERM, bool COMPENSATED>
+    ERTURK_TARGET_AVX2 static void step(__m256& sum, __m256& compensation, const __m256 x, const __m256 y,
+                                        const __m256 shift) noexcept
+    {
+        if constexpr (!COMPENSATED && TERM == Term::Dot)
+        {
+            sum = _mm256_fmadd_ps(x, y, sum);
+            return;
+        }
+        else if constexpr (!COMPENSATED && TERM == Term::SquaredDeviation)
+        {
+            const __m256 deviation = _mm256_sub_ps(x, shift);
+            sum = _mm256_fmadd_ps(deviation, deviation, sum);
+            return;
+        }
+        else if constexpr (!COMPENSATED)
+        {
+            sum = _mm256_add_ps(sum, x);
+            return;
+        }
+        else
+        {
+            __m256 value = x;
+            if constexpr (TERM == Term::Dot)
+            {
+                value = _mm256_mul_ps(x, y);
+            }
+            else if constexpr (TERM == Term::SquaredDeviation)
+            {
+                const __m256 deviation = _mm256_sub_ps(x, shift);
+                value = _mm256_mul_ps(deviation, deviation);
+            }
+
+            const __m256 corrected = _mm256_sub_ps(value, compensation);
+            const __m256 total = _mm256_add_ps(sum, corrected);
+            compensation = _mm256_sub_ps(_mm256_sub_ps(total, sum), corrected);
+            sum = total;
+        }
+    }
+
+    ERTURK_TARGET_AVX2 static __m256i tail_mask(const size_t count) noexcept
+    {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    template <Term TERM, bool COMPENSATED>
+    ERTURK_TARGET_AVX2 static float accumulate(const float* a, const float* b, const float shift,
+                                               const size_t n) noexcept
+    {
+        constexpr size_t COUNT = ACCUMULATORS<COMPENSATED>;
+        __m256 sum[COUNT];
+        __m256 compensation[COUNT];
+        for (size_t acc = 0; acc < COUNT; acc++)
+        {
+            sum[acc] = _mm256_setzero_ps();
+            compensation[acc] = _mm256_setzero_ps();
+        }
+        const __m256 shift_v = _mm256_set1_ps(shift);
+
+        size_t idx = 0;
+        for (; idx + COUNT * WIDTH <= n; idx += COUNT * WIDTH)
+        {
+#pragma GCC unroll 8
+            for (size_t acc = 0; acc < COUNT; acc++)
+            {
+                const size_t offset = idx + acc * WIDTH;
+                const __m256 x = _mm256_loadu_ps(a + offset);
+                const __m256 y = TERM == Term::Dot ? _mm256_loadu_ps(b + offset) : x;
+                step<TERM, COMPENSATED>(sum[acc], compensation[acc], x, y, shift_v);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            const __m256 x = _mm256_loadu_ps(a + idx);
+            const __m256 y = TERM == Term::Dot ? _mm256_loadu_ps(b + idx) : x;
+            step<TERM, COMPENSATED>(sum[0], compensation[0], x, y, shift_v);
+        }
+
+        if (idx < n)
+        {
+            // Masked lanes load as zero, they are cleared again after the term (a deviation of 0 is not 0)
+            const __m256i mask = tail_mask(n - idx);
+            const __m256 x = _mm256_maskload_ps(a + idx, mask);
+            const __m256 y = TERM == Term::Dot ? _mm256_maskload_ps(b + idx, mask) : x;
+
+            __m256 partial_sum = _mm256_setzero_ps();
+            __m256 partial_compensation = _mm256_setzero_ps();
+            step<TERM, false>(partial_sum, partial_compensation, x, y, shift_v);
+            step<Term::Sum, COMPENSATED>(sum[0], compensation[0],
+                                         _mm256_and_ps(partial_sum, _mm256_castsi256_ps(mask)), shift_v, shift_v);
+        }
+
+        __m256 total = _mm256_sub_ps(sum[0], compensation[0]);
+        for (size_t acc = 1; acc < COUNT; acc++)
+        {
+            total = _mm256_add_ps(total, _mm256_sub_ps(sum[acc], compensation[acc]));
+        }
+        return traits::Avx2Traits::reduce_add(total);
+    }
+
+    template <bool MAXIMUM>
+    ERTURK_TARGET_AVX2 static __m256 pick(const __m256 candidate, const __m256 current) noexcept
+    {
+        if constexpr (MAXIMUM)
+        {
+            return _mm256_max_ps(candidate, current);
+        }
+        return _mm256_min_ps(candidate, current);
+    }
+
+    template <bool MAXIMUM>
+    ERTURK_TARGET_AVX2 static float extreme(const float* a, const size_t n) noexcept
+    {
+        constexpr size_t COUNT = 4;
+        const __m256 identity = _mm256_set1_ps(MAXIMUM ? -std::numeric_limits<float>::infinity()
+                                                       : std::numeric_limits<float>::infinity());
+        __m256 current[COUNT] = {identity, identity, identity, identity};
+
+        size_t idx = 0;
+        for (; idx + COUNT * WIDTH <= n; idx += COUNT * WIDTH)
+        {
+            for (size_t acc = 0; acc < COUNT; acc++)
+            {
+                current[acc] = pick<MAXIMUM>(_mm256_loadu_ps(a + idx + acc * WIDTH), current[acc]);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            current[0] = pick<MAXIMUM>(_mm256_loadu_ps(a + idx), current[0]);
+        }
+        if (idx < n)
+        {
+            const __m256i mask = tail_mask(n - idx);
+            const __m256 x = _mm256_blendv_ps(identity, _mm256_maskload_ps(a + idx, mask), _mm256_castsi256_ps(mask));
+            current[0] = pick<MAXIMUM>(x, current[0]);
+        }
+
+        __m256 v = pick<MAXIMUM>(pick<MAXIMUM>(current[0], current[1]), pick<MAXIMUM>(current[2], current[3]));
+        v = pick<MAXIMUM>(_mm256_permute2f128_ps(v, v, 1), v);
+        v = pick<MAXIMUM>(_mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2)), v);
+        v = pick<MAXIMUM>(_mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)), v);
+        return _mm256_cvtss_f32(v);
+    }
+
+    ERTURK_TARGET_AVX2 static size_t find(const float* a, const size_t n, const float value) noexcept
+    {
+        const __m256 target = _mm256_set1_ps(value);
+        size_t idx = 0;
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a + idx), target, _CMP_EQ_OQ));
+            if (mask != 0)
+            {
+                return idx + static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+            }
+        }
+        const size_t found = ScalarReduction::find(a + idx, n - idx, value);
+        return idx + found;
+    }
+};
+
+// ************************************************* AVX-512 *************************************************
+
+// GCC 12 reports the self-initialized _mm512_undefined_ps() of its own headers as uninitialized once inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+struct Avx512Reduction
+{
+    static constexpr size_t WIDTH = 16;
+
+    template <bool COMPENSATED>
+    static constexpr size_t ACCUMULATORS = COMPENSATED ? 4 : 8;
+
+    template <Term TERM, bool COMPENSATED>
+    ERTURK_TARGET_AVX512 static void step(__m512& sum, __m512& compensation, const __m512 x, const __m512 y,
+                                          const __m512 shift) noexcept
+    {
+        if constexpr (!COMPENSATED && TERM == Term::Dot)
+        {
+            sum = _mm512_fmadd_ps(x, y, sum);
+            return;
+        }
+        else if constexpr (!COMPENSATED && TERM == Term::SquaredDeviation)
+        {
+            const __m512 deviation = _mm512_sub_ps(x, shift);
+            sum = _mm512_fmadd_ps(deviation, deviation, sum);
+            return;
+        }
+        else if constexpr (!COMPENSATED)
+        {
+            sum = _mm512_add_ps(sum, x);
+            return;
+        }
+        else
+        {
+            __m512 value = x;
+            if constexpr (TERM == Term::Dot)
+            {
+                value = _mm512_mul_ps(x, y);
+            }
+            else if constexpr (TERM == Term::SquaredDeviation)
+            {
+                const __m512 deviation = _mm512_sub_ps(x, shift);
+                value = _mm512_mul_ps(deviation, deviation);
+            }
+
+            const __m512 corrected = _mm512_sub_ps(value, compensation);
+            const __m512 total = _mm512_add_ps(sum, corrected);
+            compensation = _mm512_sub_ps(_mm512_sub_ps(total, sum), corrected);
+            sum = total;
+        }
+    }
+
+    template <Term TERM, bool COMPENSATED>
+    ERTURK_TARGET_AVX512 static float accumulate(const float* a, const float* b, const float shift,
+                                                 const size_t n) noexcept
+    {
+        constexpr size_t COUNT = ACCUMULATORS<COMPENSATED>;
+        __m512 sum[COUNT];
+        __m512 compensation[COUNT];
+        for (size_t acc = 0; acc < COUNT; acc++)
+        {
+            sum[acc] = _mm512_setzero_ps();
+            compensation[acc] = _mm512_setzero_ps();
+        }
+        const __m512 shift_v = _mm512_set1_ps(shift);
+
+        size_t idx = 0;
+        for (; idx + COUNT * WIDTH <= n; idx += COUNT * WIDTH)
+        {
+#pragma GCC unroll 8
+            for (size_t acc = 0; acc < COUNT; acc++)
+            {
+                const size_t offset = idx + acc * WIDTH;
+                const __m512 x = _mm512_loadu_ps(a + offset);
+                const __m512 y = TERM == Term::Dot ? _mm512_loadu_ps(b + offset) : x;
+                step<TERM, COMPENSATED>(sum[acc], compensation[acc], x, y, shift_v);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            const __m512 x = _mm512_loadu_ps(a + idx);
+            const __m512 y = TERM == Term::Dot ? _mm512_loadu_ps(b + idx) : x;
+            step<TERM, COMPENSATED>(sum[0], compensation[0], x, y, shift_v);
+        }
+
+        if (idx < n)
+        {
+            const auto mask = static_cast<__mmask16>((1U << (n - idx)) - 1U);
+            const __m512 x = _mm512_maskz_loadu_ps(mask, a + idx);
+            const __m512 y = TERM == Term::Dot ? _mm512_maskz_loadu_ps(mask, b + idx) : x;
+
+            __m512 partial_sum = _mm512_setzero_ps();
+            __m512 partial_compensation = _mm512_setzero_ps();
+            step<TERM, false>(partial_sum, partial_compensation, x, y, shift_v);
+            step<Term::Sum, COMPENSATED>(sum[0], compensation[0], _mm512_maskz_mov_ps(mask, partial_sum), shift_v,
+                                         shift_v);
+        }
+
+        __m512 total = _mm512_sub_ps(sum[0], compensation[0]);
+        for (size_t acc = 1; acc < COUNT; acc++)
+        {
+            total = _mm512_add_ps(total, _mm512_sub_ps(sum[acc], compensation[acc]));
+        }
+        return traits::Avx512Traits::reduce_add(total);
+    }
+
+    template <bool MAXIMUM>
+    ERTURK_TARGET_AVX512 static __m512 pick(const __m512 candidate, const __m512 current) noexcept
+    {
+        if constexpr (MAXIMUM)
+        {
+            return _mm512_max_ps(candidate, current);
+        }
+        return _mm512_min_ps(candidate, current);
+    }
+
+    template <bool MAXIMUM>
+    ERTURK_TARGET_AVX512 static float extreme(const float* a, const size_t n) noexcept
+    {
+        constexpr size_t COUNT = 4;
+        const __m512 identity = _mm512_set1_ps(MAXIMUM ? -std::numeric_limits<float>::infinity()
+                                                       : std::numeric_limits<float>::infinity());
+        __m512 current[COUNT] = {identity, identity, identity, identity};
+
+        size_t idx = 0;
+        for (; idx + COUNT * WIDTH <= n; idx += COUNT * WIDTH)
+        {
+            for (size_t acc = 0; acc < COUNT; acc++)
+            {
+                current[acc] = pick<MAXIMUM>(_mm512_loadu_ps(a + idx + acc * WIDTH), current[acc]);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            current[0] = pick<MAXIMUM>(_mm512_loadu_ps(a + idx), current[0]);
+        }
+        if (idx < n)
+        {
+            const auto mask = static_cast<__mmask16>((1U << (n - idx)) - 1U);
+            current[0] = pick<MAXIMUM>(_mm512_mask_loadu_ps(identity, mask, a + idx), current[0]);
+        }
+
+        const __m512 v = pick<MAXIMUM>(pick<MAXIMUM>(current[0], current[1]), pick<MAXIMUM>(current[2], current[3]));
+        if constexpr (MAXIMUM)
+        {
+            return _mm512_reduce_max_ps(v);
+        }
+        return _mm512_reduce_min_ps(v);
+    }
+
+    ERTURK_TARGET_AVX512 static size_t find(const float* a, const size_t n, const float value) noexcept
+    {
+        const __m512 target = _mm512_set1_ps(value);
+        size_t idx = 0;
+        for (; idx < n; idx += WIDTH)
+        {
+            const size_t count = n - idx < WIDTH ? n - idx : WIDTH;
+            const auto valid = static_cast<__mmask16>(count == WIDTH ? 0xFFFFU : (1U << count) - 1U);
+            const __mmask16 mask =
+                _mm512_mask_cmp_ps_mask(valid, _mm512_maskz_loadu_ps(valid, a + idx), target, _CMP_EQ_OQ);
+            if (mask != 0)
+            {
+                return idx + static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+            }
+        }
+        return n;
+    }
+};
+
+#pragma GCC diagnostic pop
+
+#elif defined(ERTURK_SIMD_NEON)
+
+// ************************************************* NEON *************************************************
+
+struct NeonReduction
+{
+    static constexpr size_t WIDTH = 4;
+    static constexpr size_t ACCUMULATORS = 4;
+
+    template <Term TERM, bool COMPENSATED>
+    static void step(float32x4_t& sum, float32x4_t& compensation, const float32x4_t x, const float32x4_t y,
+                     const float32x4_t shift) noexcept
+    {
+        float32x4_t value = x;
+        if constexpr (TERM == Term::Dot)
+        {
+            value = vmulq_f32(x, y);
+        }
+        else if constexpr (TERM == Term::SquaredDeviation)
+        {
+            const float32x4_t deviation = vsubq_f32(x, shift);
+            value = vmulq_f32(deviation, deviation);
+        }
+
+        if constexpr (COMPENSATED)
+        {
+            const float32x4_t corrected = vsubq_f32(value, compensation);
+            const float32x4_t total = vaddq_f32(sum, corrected);
+            compensation = vsubq_f32(vsubq_f32(total, sum), corrected);
+            sum = total;
+        }
+        else
+        {
+            sum = vaddq_f32(sum, value);
+        }
+    }
+
+    template <Term TERM, bool COMPENSATED>
+    static float accumulate(const float* a, const float* b, const float shift, const size_t n) noexcept
+    {
+        float32x4_t sum[ACCUMULATORS];
+        float32x4_t compensation[ACCUMULATORS];
+        for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+        {
+            sum[acc] = vdupq_n_f32(0.0f);
+            compensation[acc] = vdupq_n_f32(0.0f);
+        }
+        const float32x4_t shift_v = vdupq_n_f32(shift);
+
+        size_t idx = 0;
+        for (; idx + ACCUMULATORS * WIDTH <= n; idx += ACCUMULATORS * WIDTH)
+        {
+            for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+            {
+                const size_t offset = idx + acc * WIDTH;
+                const float32x4_t x = vld1q_f32(a + offset);
+                const float32x4_t y = TERM == Term::Dot ? vld1q_f32(b + offset) : x;
+                step<TERM, COMPENSATED>(sum[acc], compensation[acc], x, y, shift_v);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            const float32x4_t x = vld1q_f32(a + idx);
+            const float32x4_t y = TERM == Term::Dot ? vld1q_f32(b + idx) : x;
+            step<TERM, COMPENSATED>(sum[0], compensation[0], x, y, shift_v);
+        }
+
+        if (idx < n)
+        {
+            const size_t count = n - idx;
+            float x_tail[WIDTH] = {};
+            float y_tail[WIDTH] = {};
+            std::memcpy(x_tail, a + idx, count * sizeof(float));
+            if constexpr (TERM == Term::Dot)
+            {
+                std::memcpy(y_tail, b + idx, count * sizeof(float));
+            }
+
+            float32x4_t partial_sum = vdupq_n_f32(0.0f);
+            float32x4_t partial_compensation = vdupq_n_f32(0.0f);
+            step<TERM, false>(partial_sum, partial_compensation, vld1q_f32(x_tail), vld1q_f32(y_tail), shift_v);
+
+            const uint32_t lanes[WIDTH] = {0, 1, 2, 3};
+            const uint32x4_t mask = vcltq_u32(vld1q_u32(lanes), vdupq_n_u32(static_cast<uint32_t>(count)));
+            const float32x4_t masked = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(partial_sum), mask));
+            step<Term::Sum, COMPENSATED>(sum[0], compensation[0], masked, shift_v, shift_v);
+        }
+
+        float32x4_t total = vsubq_f32(sum[0], compensation[0]);
+        for (size_t acc = 1; acc < ACCUMULATORS; acc++)
+        {
+            total = vaddq_f32(total, vsubq_f32(sum[acc], compensation[acc]));
+        }
+        return traits::NeonTraits::reduce_add(total);
+    }
+
+    template <bool MAXIMUM>
+    static float32x4_t pick(const float32x4_t candidate, const float32x4_t current) noexcept
+    {
+        if constexpr (MAXIMUM)
+        {
+            return vbslq_f32(vcgtq_f32(candidate, current), candidate, current);
+        }
+        return vbslq_f32(vcltq_f32(candidate, current), candidate, current);
+    }
+
+    template <bool MAXIMUM>
+    static float extreme(const float* a, const size_t n) noexcept
+    {
+        const float32x4_t identity = vdupq_n_f32(MAXIMUM ? -std::numeric_limits<float>::infinity()
+                                                         : std::numeric_limits<float>::infinity());
+        float32x4_t current[ACCUMULATORS] = {identity, identity, identity, identity};
+
+        size_t idx = 0;
+        for (; idx + ACCUMULATORS * WIDTH <= n; idx += ACCUMULATORS * WIDTH)
+        {
+            for (size_t acc = 0; acc < ACCUMULATORS; acc++)
+            {
+                current[acc] = pick<MAXIMUM>(vld1q_f32(a + idx + acc * WIDTH), current[acc]);
+            }
+        }
+        for (; idx + WIDTH <= n; idx += WIDTH)
+        {
+            current[0] = pick<MAXIMUM>(vld1q_f32(a + idx), current[0]);
+        }
+
+        const float32x4_t v =
+            pick<MAXIMUM>(pick<MAXIMUM>(current[0], current[1]), pick<MAXIMUM>(current[2], current[3]));
+        float lanes[WIDTH];
+        vst1q_f32(lanes, v);
+        float result = ScalarReduction::pick<MAXIMUM>(ScalarReduction::pick<MAXIMUM>(lanes[0], lanes[1]),
+                                                      ScalarReduction::pick<MAXIMUM>(lanes[2], lanes[3]));
+        for (; idx < n; idx++)
+        {
+            result = ScalarReduction::pick<MAXIMUM>(a[idx], result);
+        }
+        return result;
+    }
+
+    static size_t find(const float* a, const size_t n, const float value) noexcept
+    {
+        return ScalarReduction::find(a, n, value);
+    }
+};
+
+#endif
+
+// ************************************************* Dispatch *************************************************
+
+struct ReductionTable
+{
+    AccumulateKernel accumulate[TERM_COUNT_][2]{};  // [term][compensated]
+    ExtremeKernel minimum{nullptr};
+    ExtremeKernel maximum{nullptr};
+    FindKernel find{nullptr};
+};
+
+template <class Reduction>
+inline ReductionTable make_reduction_table() noexcept
+{
+    ReductionTable table{};
+    table.accumulate[static_cast<size_t>(Term::Sum)][0] = Reduction::template accumulate<Term::Sum, false>;
+    table.accumulate[static_cast<size_t>(Term::Sum)][1] = Reduction::template accumulate<Term::Sum, true>;
+    table.accumulate[static_cast<size_t>(Term::Dot)][0] = Reduction::template accumulate<Term::Dot, false>;
+    table.accumulate[static_cast<size_t>(Term::Dot)][1] = Reduction::template accumulate<Term::Dot, true>;
+    table.accumulate[static_cast<size_t>(Term::SquaredDeviation)][0] =
+        Reduction::template accumulate<Term::SquaredDeviation, false>;
+    table.accumulate[static_cast<size_t>(Term::SquaredDeviation)][1] =
+        Reduction::template accumulate<Term::SquaredDeviation, true>;
+    table.minimum = Reduction::template extreme<false>;
+    table.maximum = Reduction::template extreme<true>;
+    table.find = Reduction::find;
+    return table;
+}
+
+inline ReductionTable make_reduction_table(const cpu::InstructionSet instruction_set) noexcept
+{
+    switch (instruction_set)
+    {
+#if defined(ERTURK_SIMD_X86)
+        case cpu::InstructionSet::AVX512:
+            return make_reduction_table<Avx512Reduction>();
+        case cpu::InstructionSet::AVX2:
+            return make_reduction_table<Avx2Reduction>();
+        case cpu::InstructionSet::SSE2:
+            return make_reduction_table<Sse2Reduction>();
+#elif defined(ERTURK_SIMD_NEON)
+        case cpu::InstructionSet::NEON:
+            return make_reduction_table<NeonReduction>();
+#endif
+        case cpu::InstructionSet::Scalar:
+        default:
+            return make_reduction_table<ScalarReduction>();
+    }
+}
+
+inline const ReductionTable& reduction_table() noexcept
+{
+    static const ReductionTable table = make_reduction_table(cpu::instruction_set());
+    return table;
+}
+
+inline float pairwise(const AccumulateKernel kernel, const float* a, const float* b, const float shift,
+                      const size_t n) noexcept
+{
+    if (n <= PAIRWISE_BLOCK_)
+    {
+        return kernel(a, b, shift, n);
+    }
+
+    const size_t half = (n / 2 / PAIRWISE_BLOCK_) * PAIRWISE_BLOCK_;
+    const size_t split = half != 0 ? half : PAIRWISE_BLOCK_;
+    return pairwise(kernel, a, b, shift, split) +
+           pairwise(kernel, a + split, b != nullptr ? b + split : nullptr, shift, n - split);
+}
+
+inline float accumulate(const Term term, const float* a, const float* b, const float shift, const size_t n,
+                        const Summation mode) noexcept
+{
+    const auto& kernels = reduction_table().accumulate[static_cast<size_t>(term)];
+    switch (mode)
+    {
+        case Summation::Kahan:
+            return kernels[1](a, b, shift, n);
+        case Summation::Pairwise:
+            return pairwise(kernels[0], a, b, shift, n);
+        case Summation::Fast:
+        default:
+            return kernels[0](a, b, shift, n);
+    }
+}
+
+}  // namespace reduction
+
+inline float sumFloats(const float* a, const size_t n, const Summation mode = Summation::Fast) noexcept
+{
+    return reduction::accumulate(reduction::Term::Sum, a, nullptr, 0.0f, n, mode);
+}
+
+inline float dotProduct(const float* a, const float* b, const size_t n, const Summation mode = Summation::Fast) noexcept
+{
+    return reduction::accumulate(reduction::Term::Dot, a, b, 0.0f, n, mode);
+}
+
+// Euclidean norm, no rescaling: squares above ~1.8e19 overflow to +inf
+inline float l2Norm(const float* a, const size_t n, const Summation mode = Summation::Fast) noexcept
+{
+    return std::sqrt(dotProduct(a, a, n, mode));
+}
+
+inline float minValue(const float* a, const size_t n) noexcept
+{
+    return reduction::reduction_table().minimum(a, n);
+}
+
+inline float maxValue(const float* a, const size_t n) noexcept
+{
+    return reduction::reduction_table().maximum(a, n);
+}
+
+inline size_t argMin(const float* a, const size_t n) noexcept
+{
+    const auto& table = reduction::reduction_table();
+    return table.find(a, n, table.minimum(a, n));
+}
+
+inline size_t argMax(const float* a, const size_t n) noexcept
+{
+    const auto& table = reduction::reduction_table();
+    return table.find(a, n, table.maximum(a, n));
+}
+
+// Two pass mean and population variance, {0, 0} when n == 0
+inline MeanVariance meanVariance(const float* a, const size_t n, const Summation mode = Summation::Fast) noexcept
+{
+    if (n == 0)
+    {
+        return {0.0f, 0.0f};
+    }
+
+    const auto count = static_cast<float>(n);
+    const float mean = sumFloats(a, n, mode) / count;
+    const float squared_deviation = reduction::accumulate(reduction::Term::SquaredDeviation, a, nullptr, mean, n, mode);
+    return {mean, squared_deviation / count};
+}
+
+}  // namespace erturk::simd
+
+#endif  // ERTURK_SIMD_REDUCE_H
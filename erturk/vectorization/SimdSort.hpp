@@ -0,0 +1,667 @@
+#ifndef ERTURK_SIMD_SORT_H
+#define ERTURK_SIMD_SORT_H
+
+#include "CpuFeatures.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(ERTURK_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+/*
+Vectorized ascending sort of floats, optionally carrying a uint32_t payload (e.g. the original index) with each key.
+
+AVX2 path (selected at run time):
+- Blocks of up to 64 keys are sorted in registers with bitonic networks: 8 keys per ymm register, networks for
+  1/2/4/8 registers (8/16/32/64 keys), short blocks are padded with +inf lanes and written back with masked stores.
+- Larger inputs are split by an in-place vectorized quicksort partition: every 8 keys are compared against the pivot,
+  compressed with a permutation table and stored to both ends at once, so the partition is branch free.
+- Pivot is a median of three (ninther for large ranges), recursion depth is bounded and falls back to heap sort.
+
+Other hosts fall back to std::sort. NaN keys are not ordered (like std::sort with operator<), but no key or payload
+is ever lost or duplicated.
+*/
+namespace erturk::simd
+{
+
+namespace sort_detail
+{
+
+inline constexpr size_t LANES_ = 8;
+inline constexpr size_t SMALL_SORT_ = 64;  // largest bitonic block: 8 registers
+inline constexpr size_t NINTHER_THRESHOLD_ = 1024;
+
+template <bool WITH_VALUES>
+inline uint32_t* advance(uint32_t* values, const size_t count) noexcept
+{
+    if constexpr (WITH_VALUES)
+    {
+        return values + count;
+    }
+    return values;
+}
+
+template <bool WITH_VALUES>
+inline void swap_entries(float* keys, uint32_t* values, const size_t lhs, const size_t rhs) noexcept
+{
+    std::swap(keys[lhs], keys[rhs]);
+    if constexpr (WITH_VALUES)
+    {
+        std::swap(values[lhs], values[rhs]);
+    }
+}
+
+template <bool WITH_VALUES>
+inline void insertion_sort(float* keys, uint32_t* values, const size_t n) noexcept
+{
+    for (size_t idx = 1; idx < n; idx++)
+    {
+        for (size_t pos = idx; pos > 0 && keys[pos] < keys[pos - 1]; pos--)
+        {
+            swap_entries<WITH_VALUES>(keys, values, pos, pos - 1);
+        }
+    }
+}
+
+template <bool WITH_VALUES>
+inline void sift_down(float* keys, uint32_t* values, size_t root, const size_t n) noexcept
+{
+    while (true)
+    {
+        size_t largest = root;
+        const size_t left = 2 * root + 1;
+        const size_t right = left + 1;
+        if (left < n && keys[largest] < keys[left])
+        {
+            largest = left;
+        }
+        if (right < n && keys[largest] < keys[right])
+        {
+            largest = right;
+        }
+        if (largest == root)
+        {
+            return;
+        }
+        swap_entries<WITH_VALUES>(keys, values, root, largest);
+        root = largest;
+    }
+}
+
+// Worst case guard of the quicksort, O(n log n) whatever the input
+template <bool WITH_VALUES>
+inline void heap_sort(float* keys, uint32_t* values, const size_t n) noexcept
+{
+    for (size_t idx = n / 2; idx > 0; idx--)
+    {
+        sift_down<WITH_VALUES>(keys, values, idx - 1, n);
+    }
+    for (size_t end = n; end > 1; end--)
+    {
+        swap_entries<WITH_VALUES>(keys, values, 0, end - 1);
+        sift_down<WITH_VALUES>(keys, values, 0, end - 1);
+    }
+}
+
+inline float median_of_three(const float a, const float b, const float c) noexcept
+{
+    if (a < b)
+    {
+        return b < c ? b : (a < c ? c : a);
+    }
+    return a < c ? a : (b < c ? c : b);
+}
+
+inline float choose_pivot(const float* keys, const size_t n) noexcept
+{
+    const size_t middle = n / 2;
+    if (n < NINTHER_THRESHOLD_)
+    {
+        return median_of_three(keys[0], keys[middle], keys[n - 1]);
+    }
+
+    const size_t step = n / 8;
+    return median_of_three(median_of_three(keys[0], keys[step], keys[2 * step]),
+                           median_of_three(keys[middle - step], keys[middle], keys[middle + step]),
+                           median_of_three(keys[n - 1 - 2 * step], keys[n - 1 - step], keys[n - 1]));
+}
+
+#if defined(ERTURK_SIMD_X86)
+
+// For every 8 bit "goes right" mask: lane indices of the left keys first, then the right keys, order preserved
+struct PartitionTable
+{
+    alignas(32) uint32_t permutation[256][LANES_];
+};
+
+inline constexpr PartitionTable make_partition_table() noexcept
+{
+    PartitionTable table{};
+    for (uint32_t mask = 0; mask < 256; mask++)
+    {
+        uint32_t position = 0;
+        for (uint32_t lane = 0; lane < LANES_; lane++)
+        {
+            if ((mask & (1U << lane)) == 0)
+            {
+                table.permutation[mask][position++] = lane;
+            }
+        }
+        for (uint32_t lane = 0; lane < LANES_; lane++)
+        {
+            if ((mask & (1U << lane)) != 0)
+            {
+                table.permutation[mask][position++] = lane;
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr PartitionTable PARTITION_TABLE_ = make_partition_table();
+
+// ************************************ Partner permutations of the networks ************************************
+
+struct SwapAdjacent
+{
+    ERTURK_TARGET_AVX2 static __m256 keys(const __m256 v) noexcept
+    {
+        return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+    ERTURK_TARGET_AVX2 static __m256i values(const __m256i v) noexcept
+    {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+};
+
+struct SwapPairs
+{
+    ERTURK_TARGET_AVX2 static __m256 keys(const __m256 v) noexcept
+    {
+        return _mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+    ERTURK_TARGET_AVX2 static __m256i values(const __m256i v) noexcept
+    {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+struct ReverseQuads
+{
+    ERTURK_TARGET_AVX2 static __m256 keys(const __m256 v) noexcept
+    {
+        return _mm256_permute_ps(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+    ERTURK_TARGET_AVX2 static __m256i values(const __m256i v) noexcept
+    {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+};
+
+struct SwapHalves
+{
+    ERTURK_TARGET_AVX2 static __m256 keys(const __m256 v) noexcept
+    {
+        return _mm256_permute2f128_ps(v, v, 1);
+    }
+    ERTURK_TARGET_AVX2 static __m256i values(const __m256i v) noexcept
+    {
+        return _mm256_permute2x128_si256(v, v, 1);
+    }
+};
+
+struct Reverse
+{
+    ERTURK_TARGET_AVX2 static __m256 keys(const __m256 v) noexcept
+    {
+        return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+    ERTURK_TARGET_AVX2 static __m256i values(const __m256i v) noexcept
+    {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+};
+
+// ************************************ Compare-exchange ************************************
+
+/*
+Every lane is compared with its partner lane (Partner), lanes set in HIGH_LANES keep the larger key.
+Keys only: min/max with mirrored operands, so unordered (NaN) pairs are swapped or kept, never duplicated.
+Key/value: one swap mask moves keys and values together, equal keys keep their own value.
+*/
+template <bool WITH_VALUES, class Partner, int HIGH_LANES>
+ERTURK_TARGET_AVX2 inline void exchange(__m256& keys, __m256i& values) noexcept
+{
+    const __m256 partner = Partner::keys(keys);
+    if constexpr (!WITH_VALUES)
+    {
+        keys = _mm256_blend_ps(_mm256_min_ps(keys, partner), _mm256_max_ps(keys, partner), HIGH_LANES);
+    }
+    else
+    {
+        const __m256 swap = _mm256_blend_ps(_mm256_cmp_ps(partner, keys, _CMP_LT_OQ),
+                                            _mm256_cmp_ps(partner, keys, _CMP_GT_OQ), HIGH_LANES);
+        keys = _mm256_blendv_ps(keys, partner, swap);
+        values = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(values),
+                                                      _mm256_castsi256_ps(Partner::values(values)), swap));
+    }
+}
+
+// Lane-wise: low keeps the smaller key, high the larger
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline void exchange(__m256& low_keys, __m256i& low_values, __m256& high_keys,
+                                        __m256i& high_values) noexcept
+{
+    if constexpr (!WITH_VALUES)
+    {
+        const __m256 minimum = _mm256_min_ps(low_keys, high_keys);
+        high_keys = _mm256_max_ps(high_keys, low_keys);
+        low_keys = minimum;
+    }
+    else
+    {
+        const __m256 swap = _mm256_cmp_ps(high_keys, low_keys, _CMP_LT_OQ);
+        const __m256 low = _mm256_blendv_ps(low_keys, high_keys, swap);
+        high_keys = _mm256_blendv_ps(high_keys, low_keys, swap);
+        low_keys = low;
+
+        const __m256 low_v = _mm256_castsi256_ps(low_values);
+        const __m256 high_v = _mm256_castsi256_ps(high_values);
+        low_values = _mm256_castps_si256(_mm256_blendv_ps(low_v, high_v, swap));
+        high_values = _mm256_castps_si256(_mm256_blendv_ps(high_v, low_v, swap));
+    }
+}
+
+// ************************************ Bitonic networks ************************************
+
+// Full sort of the 8 lanes of one register
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline void sort_register(__m256& keys, __m256i& values) noexcept
+{
+    exchange<WITH_VALUES, SwapAdjacent, 0b10101010>(keys, values);
+    exchange<WITH_VALUES, ReverseQuads, 0b11001100>(keys, values);
+    exchange<WITH_VALUES, SwapAdjacent, 0b10101010>(keys, values);
+    exchange<WITH_VALUES, Reverse, 0b11110000>(keys, values);
+    exchange<WITH_VALUES, SwapPairs, 0b11001100>(keys, values);
+    exchange<WITH_VALUES, SwapAdjacent, 0b10101010>(keys, values);
+}
+
+// Sorts the 8 lanes of a bitonic register (half cleaners at distance 4, 2, 1)
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline void merge_register(__m256& keys, __m256i& values) noexcept
+{
+    exchange<WITH_VALUES, SwapHalves, 0b11110000>(keys, values);
+    exchange<WITH_VALUES, SwapPairs, 0b11001100>(keys, values);
+    exchange<WITH_VALUES, SwapAdjacent, 0b10101010>(keys, values);
+}
+
+// Sorts REGISTERS * 8 keys held in registers, REGISTERS is a power of two
+template <bool WITH_VALUES, size_t REGISTERS>
+ERTURK_TARGET_AVX2 inline void sort_registers(__m256* keys, __m256i* values) noexcept
+{
+    for (size_t reg = 0; reg < REGISTERS; reg++)
+    {
+        sort_register<WITH_VALUES>(keys[reg], values[reg]);
+    }
+
+    // Merge sorted runs of width / 2 registers into runs of width registers
+    for (size_t width = 2; width <= REGISTERS; width *= 2)
+    {
+        for (size_t group = 0; group < REGISTERS; group += width)
+        {
+            // Compare element i with element (2m - 1 - i): lower half takes minimums, upper half maximums
+            for (size_t idx = 0; idx < width / 2; idx++)
+            {
+                const size_t upper = group + width - 1 - idx;
+                keys[upper] = Reverse::keys(keys[upper]);
+                values[upper] = Reverse::values(values[upper]);
+                exchange<WITH_VALUES>(keys[group + idx], values[group + idx], keys[upper], values[upper]);
+            }
+            // Upper registers now hold the maximums in reversed order: restore register order (lanes are already
+            // reversed), a reversed bitonic sequence is still bitonic
+            for (size_t idx = 0; idx < width / 4; idx++)
+            {
+                std::swap(keys[group + width / 2 + idx], keys[group + width - 1 - idx]);
+                std::swap(values[group + width / 2 + idx], values[group + width - 1 - idx]);
+            }
+
+            // Half cleaners across registers, then inside each register
+            for (size_t distance = width / 4; distance >= 1; distance /= 2)
+            {
+                for (size_t block = group; block < group + width; block += 2 * distance)
+                {
+                    for (size_t idx = block; idx < block + distance; idx++)
+                    {
+                        exchange<WITH_VALUES>(keys[idx], values[idx], keys[idx + distance], values[idx + distance]);
+                    }
+                }
+            }
+            for (size_t reg = group; reg < group + width; reg++)
+            {
+                merge_register<WITH_VALUES>(keys[reg], values[reg]);
+            }
+        }
+    }
+}
+
+// Lane i is active when i < count
+ERTURK_TARGET_AVX2 inline __m256i lane_mask(const size_t count) noexcept
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+// Sorts n <= REGISTERS * 8 entries, missing lanes are padded with +inf and never stored
+template <bool WITH_VALUES, size_t REGISTERS>
+ERTURK_TARGET_AVX2 inline void sort_block(float* keys, uint32_t* values, const size_t n) noexcept
+{
+    __m256 key_registers[REGISTERS];
+    __m256i value_registers[REGISTERS];
+
+    const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256 unsupported = _mm256_setzero_ps();
+
+    for (size_t reg = 0; reg < REGISTERS; reg++)
+    {
+        const size_t offset = reg * LANES_;
+        const size_t count = n > offset ? std::min(LANES_, n - offset) : 0;
+        const __m256i mask = lane_mask(count);
+
+        value_registers[reg] = _mm256_setzero_si256();
+        if (count == 0)
+        {
+            key_registers[reg] = infinity;
+            continue;
+        }
+
+        const __m256 loaded = _mm256_maskload_ps(keys + offset, mask);
+        if constexpr (WITH_VALUES)
+        {
+            // A real +inf (or NaN) key could trade places with a padding lane and lose its value
+            unsupported = _mm256_or_ps(unsupported, _mm256_cmp_ps(loaded, infinity, _CMP_NLT_UQ));
+            value_registers[reg] = _mm256_maskload_epi32(reinterpret_cast<const int*>(values + offset), mask);
+        }
+        else
+        {
+            unsupported = _mm256_or_ps(unsupported, _mm256_cmp_ps(loaded, loaded, _CMP_UNORD_Q));
+        }
+        key_registers[reg] = _mm256_blendv_ps(infinity, loaded, _mm256_castsi256_ps(mask));
+    }
+
+    if (_mm256_movemask_ps(unsupported) != 0)
+    {
+        insertion_sort<WITH_VALUES>(keys, values, n);
+        return;
+    }
+
+    sort_registers<WITH_VALUES, REGISTERS>(key_registers, value_registers);
+
+    for (size_t reg = 0; reg < REGISTERS; reg++)
+    {
+        const size_t offset = reg * LANES_;
+        const size_t count = n > offset ? std::min(LANES_, n - offset) : 0;
+        if (count == 0)
+        {
+            break;
+        }
+
+        const __m256i mask = lane_mask(count);
+        _mm256_maskstore_ps(keys + offset, mask, key_registers[reg]);
+        if constexpr (WITH_VALUES)
+        {
+            _mm256_maskstore_epi32(reinterpret_cast<int*>(values + offset), mask, value_registers[reg]);
+        }
+    }
+}
+
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline void small_sort(float* keys, uint32_t* values, const size_t n) noexcept
+{
+    if (n < 2)
+    {
+        return;
+    }
+    if (n <= LANES_)
+    {
+        sort_block<WITH_VALUES, 1>(keys, values, n);
+    }
+    else if (n <= 2 * LANES_)
+    {
+        sort_block<WITH_VALUES, 2>(keys, values, n);
+    }
+    else if (n <= 4 * LANES_)
+    {
+        sort_block<WITH_VALUES, 4>(keys, values, n);
+    }
+    else
+    {
+        sort_block<WITH_VALUES, 8>(keys, values, n);
+    }
+}
+
+// ************************************ Partition ************************************
+
+// Writes 8 entries compressed to both ends: left ones at left_write, right ones ending at right_write
+template <bool WITH_VALUES, int RIGHT_PREDICATE>
+ERTURK_TARGET_AVX2 inline void partition_vector(__m256 key_vector, __m256i value_vector, const __m256 pivot,
+                                                float* keys, uint32_t* values, size_t& left_write,
+                                                size_t& right_write) noexcept
+{
+    const int mask = _mm256_movemask_ps(_mm256_cmp_ps(key_vector, pivot, RIGHT_PREDICATE));
+    const __m256i permutation =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(PARTITION_TABLE_.permutation[mask]));
+    const auto right_count = static_cast<size_t>(__builtin_popcount(static_cast<unsigned int>(mask)));
+
+    key_vector = _mm256_permutevar8x32_ps(key_vector, permutation);
+    _mm256_storeu_ps(keys + left_write, key_vector);
+    _mm256_storeu_ps(keys + right_write - LANES_, key_vector);
+
+    if constexpr (WITH_VALUES)
+    {
+        value_vector = _mm256_permutevar8x32_epi32(value_vector, permutation);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + left_write), value_vector);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + right_write - LANES_), value_vector);
+    }
+
+    left_write += LANES_ - right_count;
+    right_write -= right_count;
+}
+
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline __m256i load_values(const uint32_t* values, const size_t offset) noexcept
+{
+    if constexpr (WITH_VALUES)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + offset));
+    }
+    return _mm256_setzero_si256();
+}
+
+/*
+In-place partition of n >= 16 entries, returns the count of entries that go left.
+RIGHT_PREDICATE is _CMP_NLT_UQ (left: key < pivot) or _CMP_NLE_UQ (left: key <= pivot), NaN keys go right.
+
+The first and last 8 entries are saved first, which leaves exactly 16 free slots split between both ends. Each step
+reads 8 entries from the end with the fewest free slots, so both ends always have room for a full 8 lane store.
+*/
+template <bool WITH_VALUES, int RIGHT_PREDICATE>
+ERTURK_TARGET_AVX2 inline size_t partition(float* keys, uint32_t* values, const size_t n, const float pivot) noexcept
+{
+    constexpr size_t SPARE_ = 3 * LANES_;
+    float spare_keys[SPARE_];
+    uint32_t spare_values[SPARE_];
+
+    std::copy_n(keys, LANES_, spare_keys);
+    std::copy_n(keys + n - LANES_, LANES_, spare_keys + LANES_);
+    if constexpr (WITH_VALUES)
+    {
+        std::copy_n(values, LANES_, spare_values);
+        std::copy_n(values + n - LANES_, LANES_, spare_values + LANES_);
+    }
+
+    const __m256 pivot_vector = _mm256_set1_ps(pivot);
+    size_t left_read = LANES_;
+    size_t right_read = n - LANES_;
+    size_t left_write = 0;
+    size_t right_write = n;
+
+    while (right_read - left_read >= LANES_)
+    {
+        size_t offset = 0;
+        if (left_read - left_write <= right_write - right_read)
+        {
+            offset = left_read;
+            left_read += LANES_;
+        }
+        else
+        {
+            right_read -= LANES_;
+            offset = right_read;
+        }
+
+        partition_vector<WITH_VALUES, RIGHT_PREDICATE>(_mm256_loadu_ps(keys + offset),
+                                                       load_values<WITH_VALUES>(values, offset),
+                                                       pivot_vector, keys, values, left_write, right_write);
+    }
+
+    // Saved entries plus the last (< 8) unread ones fill the remaining free slots exactly
+    const size_t remaining = right_read - left_read;
+    std::copy_n(keys + left_read, remaining, spare_keys + 2 * LANES_);
+    if constexpr (WITH_VALUES)
+    {
+        std::copy_n(values + left_read, remaining, spare_values + 2 * LANES_);
+    }
+
+    for (size_t idx = 0; idx < 2 * LANES_ + remaining; idx++)
+    {
+        const float key = spare_keys[idx];
+        const bool right = RIGHT_PREDICATE == _CMP_NLT_UQ ? !(key < pivot) : !(key <= pivot);
+        const size_t target = right ? --right_write : left_write++;
+        keys[target] = key;
+        if constexpr (WITH_VALUES)
+        {
+            values[target] = spare_values[idx];
+        }
+    }
+
+    return left_write;
+}
+
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline void quicksort(float* keys, uint32_t* values, size_t n, size_t depth) noexcept
+{
+    while (n > SMALL_SORT_)
+    {
+        if (depth == 0)
+        {
+            heap_sort<WITH_VALUES>(keys, values, n);
+            return;
+        }
+        depth--;
+
+        const float pivot = choose_pivot(keys, n);
+        size_t middle = partition<WITH_VALUES, _CMP_NLT_UQ>(keys, values, n, pivot);
+
+        if (middle == 0)
+        {
+            // Nothing below the pivot: split off the keys equal to it, they are already in their final place
+            middle = partition<WITH_VALUES, _CMP_NLE_UQ>(keys, values, n, pivot);
+            if (middle == 0)
+            {
+                heap_sort<WITH_VALUES>(keys, values, n);  // unordered pivot (NaN)
+                return;
+            }
+            keys += middle;
+            values = advance<WITH_VALUES>(values, middle);
+            n -= middle;
+            continue;
+        }
+
+        // Recurse into the smaller side, iterate on the larger one: stack depth stays O(log n)
+        if (middle < n - middle)
+        {
+            quicksort<WITH_VALUES>(keys, values, middle, depth);
+            keys += middle;
+            values = advance<WITH_VALUES>(values, middle);
+            n -= middle;
+        }
+        else
+        {
+            quicksort<WITH_VALUES>(keys + middle, advance<WITH_VALUES>(values, middle), n - middle, depth);
+            n = middle;
+        }
+    }
+
+    small_sort<WITH_VALUES>(keys, values, n);
+}
+
+template <bool WITH_VALUES>
+ERTURK_TARGET_AVX2 inline void sort_avx2(float* keys, uint32_t* values, const size_t n) noexcept
+{
+    size_t depth = 0;
+    for (size_t size = n; size > 1; size >>= 1)
+    {
+        depth += 2;
+    }
+    quicksort<WITH_VALUES>(keys, values, n, depth);
+}
+
+inline bool use_avx2() noexcept
+{
+    const cpu::InstructionSet instruction_set = cpu::instruction_set();
+    return instruction_set == cpu::InstructionSet::AVX2 || instruction_set == cpu::InstructionSet::AVX512;
+}
+
+#endif
+
+inline void sort_key_value_fallback(float* keys, uint32_t* values, const size_t n)
+{
+    std::vector<std::pair<float, uint32_t>> entries(n);
+    for (size_t idx = 0; idx < n; idx++)
+    {
+        entries[idx] = {keys[idx], values[idx]};
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (size_t idx = 0; idx < n; idx++)
+    {
+        keys[idx] = entries[idx].first;
+        values[idx] = entries[idx].second;
+    }
+}
+
+}  // namespace sort_detail
+
+// Ascending sort of n floats
+inline void sortFloats(float* data, const size_t n)
+{
+#if defined(ERTURK_SIMD_X86)
+    if (sort_detail::use_avx2())
+    {
+        sort_detail::sort_avx2<false>(data, nullptr, n);
+        return;
+    }
+#endif
+    std::sort(data, data + n);
+}
+
+// Ascending sort of n keys, values[i] moves with keys[i] (not stable: order of equal keys is unspecified)
+inline void sortKeyValue(float* keys, uint32_t* values, const size_t n)
+{
+#if defined(ERTURK_SIMD_X86)
+    if (sort_detail::use_avx2())
+    {
+        sort_detail::sort_avx2<true>(keys, values, n);
+        return;
+    }
+#endif
+    sort_detail::sort_key_value_fallback(keys, values, n);
+}
+
+}  // namespace erturk::simd
+
+#endif  // ERTURK_SIMD_SORT_H
@@ -0,0 +1,517 @@
+#ifndef ERTURK_SIMD_TRAITS_H
+#define ERTURK_SIMD_TRAITS_H
+
+#include "CpuFeatures.hpp"
+#include <cstddef>
+
+#if defined(ERTURK_SIMD_X86)
+#include <immintrin.h>
+#elif defined(ERTURK_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+Per instruction set vector traits for float kernels.
+
+Every member that touches a vector register carries the target attribute of its instruction set, vector values never
+cross into generic (untargeted) code: generic kernels only pass pointers into the traits, so they stay ABI safe at any
+optimization level and inline completely into the flattened per instruction set entry points of SimdDispatch.hpp.
+
+Traits contract:
+- WIDTH                                 : floats per vector, ALIGNMENT is the matching byte alignment.
+- binary<Op, ALIGNED>(a, b, result)     : one full vector, ALIGNED selects load/store instead of loadu/storeu.
+- unary<Op, ALIGNED>(a, result)         : same for one operand.
+- MASKED_TAIL                           : true when binary_tail/unary_tail exist, they process count < WIDTH
+                                          elements with masked loads and stores, so no byte past the end is touched.
+- reduce_add(v)                         : horizontal sum of one vector, in registers (not for ScalarTraits).
+*/
+namespace erturk::simd
+{
+
+namespace op
+{
+
+struct Add
+{
+    static constexpr float scalar(const float a, const float b) noexcept
+    {
+        return a + b;
+    }
+};
+
+struct Subtract
+{
+    static constexpr float scalar(const float a, const float b) noexcept
+    {
+        return a - b;
+    }
+};
+
+struct Multiply
+{
+    static constexpr float scalar(const float a, const float b) noexcept
+    {
+        return a * b;
+    }
+};
+
+struct Divide
+{
+    static constexpr float scalar(const float a, const float b) noexcept
+    {
+        return a / b;
+    }
+};
+
+// Matches minps/maxps: second operand is returned when the comparison is unordered (NaN)
+struct Min
+{
+    static constexpr float scalar(const float a, const float b) noexcept
+    {
+        return a < b ? a : b;
+    }
+};
+
+struct Max
+{
+    static constexpr float scalar(const float a, const float b) noexcept
+    {
+        return a > b ? a : b;
+    }
+};
+
+struct Reciprocal
+{
+    static constexpr float scalar(const float a) noexcept
+    {
+        return 1.0f / a;
+    }
+};
+
+}  // namespace op
+
+namespace traits
+{
+
+// ************************************************* Scalar *************************************************
+
+struct ScalarTraits
+{
+    static constexpr size_t WIDTH = 1;
+    static constexpr size_t ALIGNMENT = alignof(float);
+    static constexpr bool MASKED_TAIL = false;
+    static constexpr cpu::InstructionSet INSTRUCTION_SET = cpu::InstructionSet::Scalar;
+
+    template <class Op, bool ALIGNED = false>
+    static void binary(const float* a, const float* b, float* result) noexcept
+    {
+        *result = Op::scalar(*a, *b);
+    }
+
+    template <class Op, bool ALIGNED = false>
+    static void unary(const float* a, float* result) noexcept
+    {
+        *result = Op::scalar(*a);
+    }
+};
+
+#if defined(ERTURK_SIMD_X86)
+
+// ************************************************* SSE2 *************************************************
+
+struct Sse2Traits
+{
+    static constexpr size_t WIDTH = 4;
+    static constexpr size_t ALIGNMENT = sizeof(__m128);
+    static constexpr bool MASKED_TAIL = false;
+    static constexpr cpu::InstructionSet INSTRUCTION_SET = cpu::InstructionSet::SSE2;
+
+    template <class Op, bool ALIGNED = false>
+    ERTURK_TARGET_SSE2 static void binary(const float* a, const float* b, float* result) noexcept
+    {
+        store<ALIGNED>(result, apply(Op{}, load<ALIGNED>(a), load<ALIGNED>(b)));
+    }
+
+    template <class Op, bool ALIGNED = false>
+    ERTURK_TARGET_SSE2 static void unary(const float* a, float* result) noexcept
+    {
+        store<ALIGNED>(result, apply(Op{}, load<ALIGNED>(a)));
+    }
+
+    template <bool ALIGNED>
+    ERTURK_TARGET_SSE2 static __m128 load(const float* source) noexcept
+    {
+        if constexpr (ALIGNED)
+        {
+            return _mm_load_ps(source);
+        }
+        return _mm_loadu_ps(source);
+    }
+
+    template <bool ALIGNED>
+    ERTURK_TARGET_SSE2 static void store(float* destination, const __m128 v) noexcept
+    {
+        if constexpr (ALIGNED)
+        {
+            _mm_store_ps(destination, v);
+        }
+        else
+        {
+            _mm_storeu_ps(destination, v);
+        }
+    }
+
+    ERTURK_TARGET_SSE2 static float reduce_add(const __m128 v) noexcept
+    {
+        const __m128 high = _mm_movehl_ps(v, v);                         // [2, 3, 2, 3]
+        const __m128 pair = _mm_add_ps(v, high);                         // [0+2, 1+3, ...]
+        const __m128 odd = _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1));
+        return _mm_cvtss_f32(_mm_add_ss(pair, odd));
+    }
+
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Add, const __m128 a, const __m128 b) noexcept
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Subtract, const __m128 a, const __m128 b) noexcept
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Multiply, const __m128 a, const __m128 b) noexcept
+    {
+        return _mm_mul_ps(a, b);
+    }
+
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Divide, const __m128 a, const __m128 b) noexcept
+    {
+        return _mm_div_ps(a, b);
+    }
+
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Min, const __m128 a, const __m128 b) noexcept
+    {
+        return _mm_min_ps(a, b);
+    }
+
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Max, const __m128 a, const __m128 b) noexcept
+    {
+        return _mm_max_ps(a, b);
+    }
+
+    // rcpps (12 bit) refined with one Newton-Raphson step: x1 = x0 * (2 - a * x0)
+    ERTURK_TARGET_SSE2 static __m128 apply(op::Reciprocal, const __m128 a) noexcept
+    {
+        const __m128 x0 = _mm_rcp_ps(a);
+        return _mm_mul_ps(x0, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(a, x0)));
+    }
+};
+
+// ************************************************* AVX2 *************************************************
+
+struct Avx2Traits
+{
+    static constexpr size_t WIDTH = 8;
+    static constexpr size_t ALIGNMENT = sizeof(__m256);
+    static constexpr bool MASKED_TAIL = true;
+    static constexpr cpu::InstructionSet INSTRUCTION_SET = cpu::InstructionSet::AVX2;
+
+    template <class Op, bool ALIGNED = false>
+    ERTURK_TARGET_AVX2 static void binary(const float* a, const float* b, float* result) noexcept
+    {
+        store<ALIGNED>(result, apply(Op{}, load<ALIGNED>(a), load<ALIGNED>(b)));
+    }
+
+    template <class Op, bool ALIGNED = false>
+    ERTURK_TARGET_AVX2 static void unary(const float* a, float* result) noexcept
+    {
+        store<ALIGNED>(result, apply(Op{}, load<ALIGNED>(a)));
+    }
+
+    // Lanes past count read as zero and are never written
+    template <class Op>
+    ERTURK_TARGET_AVX2 static void binary_tail(const float* a, const float* b, float* result,
+                                               const size_t count) noexcept
+    {
+        const __m256i mask = tail_mask(count);
+        _mm256_maskstore_ps(result, mask, apply(Op{}, _mm256_maskload_ps(a, mask), _mm256_maskload_ps(b, mask)));
+    }
+
+    template <class Op>
+    ERTURK_TARGET_AVX2 static void unary_tail(const float* a, float* result, const size_t count) noexcept
+    {
+        const __m256i mask = tail_mask(count);
+        _mm256_maskstore_ps(result, mask, apply(Op{}, _mm256_maskload_ps(a, mask)));
+    }
+
+    // Sign bit set on the first count lanes
+    ERTURK_TARGET_AVX2 static __m256i tail_mask(const size_t count) noexcept
+    {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    template <bool ALIGNED>
+    ERTURK_TARGET_AVX2 static __m256 load(const float* source) noexcept
+    {
+        if constexpr (ALIGNED)
+        {
+            return _mm256_load_ps(source);
+        }
+        return _mm256_loadu_ps(source);
+    }
+
+    template <bool ALIGNED>
+    ERTURK_TARGET_AVX2 static void store(float* destination, const __m256 v) noexcept
+    {
+        if constexpr (ALIGNED)
+        {
+            _mm256_store_ps(destination, v);
+        }
+        else
+        {
+            _mm256_storeu_ps(destination, v);
+        }
+    }
+
+    ERTURK_TARGET_AVX2 static float reduce_add(const __m256 v) noexcept
+    {
+        const __m128 quad = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        const __m128 pair = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+        return _mm_cvtss_f32(_mm_add_ss(pair, _mm_movehdup_ps(pair)));
+    }
+
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Add, const __m256 a, const __m256 b) noexcept
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Subtract, const __m256 a, const __m256 b) noexcept
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Multiply, const __m256 a, const __m256 b) noexcept
+    {
+        return _mm256_mul_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Divide, const __m256 a, const __m256 b) noexcept
+    {
+        return _mm256_div_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Min, const __m256 a, const __m256 b) noexcept
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Max, const __m256 a, const __m256 b) noexcept
+    {
+        return _mm256_max_ps(a, b);
+    }
+
+    // rcpps (12 bit) refined with one Newton-Raphson step: x1 = x0 * (2 - a * x0)
+    ERTURK_TARGET_AVX2 static __m256 apply(op::Reciprocal, const __m256 a) noexcept
+    {
+        const __m256 x0 = _mm256_rcp_ps(a);
+        return _mm256_mul_ps(x0, _mm256_fnmadd_ps(a, x0, _mm256_set1_ps(2.0f)));
+    }
+};
+
+// ************************************************* AVX-512 *************************************************
+
+// GCC 12 reports the self-initialized _mm512_undefined_ps() of its own headers as uninitialized once inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+struct Avx512Traits
+{
+    static constexpr size_t WIDTH = 16;
+    static constexpr size_t ALIGNMENT = sizeof(__m512);
+    static constexpr bool MASKED_TAIL = true;
+    static constexpr cpu::InstructionSet INSTRUCTION_SET = cpu::InstructionSet::AVX512;
+
+    template <class Op, bool ALIGNED = false>
+    ERTURK_TARGET_AVX512 static void binary(const float* a, const float* b, float* result) noexcept
+    {
+        store<ALIGNED>(result, apply(Op{}, load<ALIGNED>(a), load<ALIGNED>(b)));
+    }
+
+    template <class Op, bool ALIGNED = false>
+    ERTURK_TARGET_AVX512 static void unary(const float* a, float* result) noexcept
+    {
+        store<ALIGNED>(result, apply(Op{}, load<ALIGNED>(a)));
+    }
+
+    // Lanes past count read as zero and are never written, masked lanes do not fault
+    template <class Op>
+    ERTURK_TARGET_AVX512 static void binary_tail(const float* a, const float* b, float* result,
+                                                 const size_t count) noexcept
+    {
+        const __mmask16 mask = static_cast<__mmask16>((1U << count) - 1U);
+        _mm512_mask_storeu_ps(result, mask,
+                              apply(Op{}, _mm512_maskz_loadu_ps(mask, a), _mm512_maskz_loadu_ps(mask, b)));
+    }
+
+    template <class Op>
+    ERTURK_TARGET_AVX512 static void unary_tail(const float* a, float* result, const size_t count) noexcept
+    {
+        const __mmask16 mask = static_cast<__mmask16>((1U << count) - 1U);
+        _mm512_mask_storeu_ps(result, mask, apply(Op{}, _mm512_maskz_loadu_ps(mask, a)));
+    }
+
+    ERTURK_TARGET_AVX512 static float reduce_add(const __m512 v) noexcept
+    {
+        return _mm512_reduce_add_ps(v);
+    }
+
+    template <bool ALIGNED>
+    ERTURK_TARGET_AVX512 static __m512 load(const float* source) noexcept
+    {
+        if constexpr (ALIGNED)
+        {
+            return _mm512_load_ps(source);
+        }
+        return _mm512_loadu_ps(source);
+    }
+
+    template <bool ALIGNED>
+    ERTURK_TARGET_AVX512 static void store(float* destination, const __m512 v) noexcept
+    {
+        if constexpr (ALIGNED)
+        {
+            _mm512_store_ps(destination, v);
+        }
+        else
+        {
+            _mm512_storeu_ps(destination, v);
+        }
+    }
+
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Add, const __m512 a, const __m512 b) noexcept
+    {
+        return _mm512_add_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Subtract, const __m512 a, const __m512 b) noexcept
+    {
+        return _mm512_sub_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Multiply, const __m512 a, const __m512 b) noexcept
+    {
+        return _mm512_mul_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Divide, const __m512 a, const __m512 b) noexcept
+    {
+        return _mm512_div_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Min, const __m512 a, const __m512 b) noexcept
+    {
+        return _mm512_min_ps(a, b);
+    }
+
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Max, const __m512 a, const __m512 b) noexcept
+    {
+        return _mm512_max_ps(a, b);
+    }
+
+    // rcp14ps (14 bit) refined with one Newton-Raphson step: x1 = x0 * (2 - a * x0)
+    ERTURK_TARGET_AVX512 static __m512 apply(op::Reciprocal, const __m512 a) noexcept
+    {
+        const __m512 x0 = _mm512_rcp14_ps(a);
+        return _mm512_mul_ps(x0, _mm512_fnmadd_ps(a, x0, _mm512_set1_ps(2.0f)));
+    }
+};
+
+#pragma GCC diagnostic pop
+
+#elif defined(ERTURK_SIMD_NEON)
+
+// ************************************************* NEON *************************************************
+
+struct NeonTraits
+{
+    static constexpr size_t WIDTH = 4;
+    static constexpr size_t ALIGNMENT = sizeof(float32x4_t);
+    static constexpr bool MASKED_TAIL = false;
+    static constexpr cpu::InstructionSet INSTRUCTION_SET = cpu::InstructionSet::NEON;
+
+    // vld1q/vst1q have no alignment requirement and no aligned variant
+    template <class Op, bool ALIGNED = false>
+    static void binary(const float* a, const float* b, float* result) noexcept
+    {
+        vst1q_f32(result, apply(Op{}, vld1q_f32(a), vld1q_f32(b)));
+    }
+
+    template <class Op, bool ALIGNED = false>
+    static void unary(const float* a, float* result) noexcept
+    {
+        vst1q_f32(result, apply(Op{}, vld1q_f32(a)));
+    }
+
+    static float reduce_add(const float32x4_t v) noexcept
+    {
+#if defined(__aarch64__)
+        return vaddvq_f32(v);
+#else
+        const float32x2_t pair = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+    }
+
+    static float32x4_t apply(op::Add, const float32x4_t a, const float32x4_t b) noexcept
+    {
+        return vaddq_f32(a, b);
+    }
+
+    static float32x4_t apply(op::Subtract, const float32x4_t a, const float32x4_t b) noexcept
+    {
+        return vsubq_f32(a, b);
+    }
+
+    static float32x4_t apply(op::Multiply, const float32x4_t a, const float32x4_t b) noexcept
+    {
+        return vmulq_f32(a, b);
+    }
+
+    static float32x4_t apply(op::Divide, const float32x4_t a, const float32x4_t b) noexcept
+    {
+#if defined(__aarch64__)
+        return vdivq_f32(a, b);
+#else
+        return vmulq_f32(a, apply(op::Reciprocal{}, b));
+#endif
+    }
+
+    // Same unordered semantics as op::Min::scalar (second operand on NaN)
+    static float32x4_t apply(op::Min, const float32x4_t a, const float32x4_t b) noexcept
+    {
+        return vbslq_f32(vcltq_f32(a, b), a, b);
+    }
+
+    static float32x4_t apply(op::Max, const float32x4_t a, const float32x4_t b) noexcept
+    {
+        return vbslq_f32(vcgtq_f32(a, b), a, b);
+    }
+
+    // vrecpe (8 bit) refined with two Newton-Raphson steps (vrecps computes 2 - a * x)
+    static float32x4_t apply(op::Reciprocal, const float32x4_t a) noexcept
+    {
+        float32x4_t x = vrecpeq_f32(a);
+        x = vmulq_f32(x, vrecpsq_f32(a, x));
+        x = vmulq_f32(x, vrecpsq_f32(a, x));
+        return x;
+    }
+};
+
+#endif
+
+}  // namespace traits
+
+}  // namespace erturk::simd
+
+#endif  // ERTURK_SIMD_TRAITS_H
@@ -0,0 +1,41 @@
+// g++ -std=c++20 -O3 -pthread -o gemm_benchmark gemm_benchmark.cpp
+
+#include "../../erturk/linear_algebra/Gemm.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main()
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::cout << std::setw(8) << "size" << std::setw(14) << "GFLOP/s" << "\n";
+
+    for (const size_t size : {512, 1024, 2048, 4096})
+    {
+        std::vector<float> a(size * size);
+        std::vector<float> b(size * size);
+        std::vector<float> c(size * size);
+        for (auto& value : a)
+        {
+            value = distribution(generator);
+        }
+        for (auto& value : b)
+        {
+            value = distribution(generator);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        erturk::linear_algebra::sgemm(size, size, size, a.data(), size, b.data(), size, c.data(), size);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double flops = 2.0 * static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(size);
+        std::cout << std::setw(8) << size << std::setw(14) << std::fixed << std::setprecision(2)
+                  << flops / elapsed.count() / 1e9 << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+// g++ -std=c++20 -O3 -o memcpy_benchmark memcpy_benchmark.cpp
+
+#include "../../erturk/memory/Memory.hpp"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t MIN_SIZE = 8;
+constexpr size_t MAX_SIZE = 64 * 1024 * 1024;
+constexpr size_t BYTES_PER_SAMPLE = 512 * 1024 * 1024;  // keep each measurement roughly equally long
+
+template <typename CopyFunction>
+double measure_gbps(CopyFunction&& copy_function, unsigned char* dst, const unsigned char* src, const size_t size)
+{
+    const size_t iterations = BYTES_PER_SAMPLE / size + 1;
+
+    copy_function(dst, src, size);  // warm up caches and page tables
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t idx = 0; idx < iterations; idx++)
+    {
+        copy_function(dst, src, size);
+        asm volatile("" : : "r"(dst) : "memory");  // keep the copy observable
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+    return (static_cast<double>(size) * static_cast<double>(iterations)) / seconds / 1e9;
+}
+
+}  // namespace
+
+int main()
+{
+    // +64 allows misaligned source/destination offsets
+    std::vector<unsigned char> source(MAX_SIZE + 64, 0xAB);
+    std::vector<unsigned char> destination(MAX_SIZE + 64, 0x00);
+
+    const auto libc_memcpy = [](unsigned char* dst, const unsigned char* src, const size_t size) {
+        std::memcpy(dst, src, size);
+    };
+
+    const auto erturk_memcpy = [](unsigned char* dst, const unsigned char* src, const size_t size) {
+        erturk::memory::memcpy(src, dst, size);
+    };
+
+    const auto libc_memset = [](unsigned char* dst, const unsigned char*, const size_t size) {
+        std::memset(dst, 0x5A, size);
+    };
+
+    const auto erturk_memset = [](unsigned char* dst, const unsigned char*, const size_t size) {
+        erturk::memory::memset(dst, 0x5A, size);
+    };
+
+    std::cout << std::setw(12) << "size" << std::setw(10) << "offset" << std::setw(16) << "libc memcpy"
+              << std::setw(16) << "erturk memcpy" << std::setw(16) << "libc memset" << std::setw(16)
+              << "erturk memset" << "   (GB/s)\n";
+
+    for (size_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2)
+    {
+        for (const size_t offset : {size_t{0}, size_t{7}})
+        {
+            unsigned char* dst = destination.data() + offset;
+            const unsigned char* src = source.data() + (offset * 3) % 64;
+
+            std::cout << std::setw(12) << size << std::setw(10) << offset << std::fixed << std::setprecision(2)
+                      << std::setw(16) << measure_gbps(libc_memcpy, dst, src, size) << std::setw(16)
+                      << measure_gbps(erturk_memcpy, dst, src, size) << std::setw(16)
+                      << measure_gbps(libc_memset, dst, src, size) << std::setw(16)
+                      << measure_gbps(erturk_memset, dst, src, size) << "\n";
+        }
+    }
+
+    return 0;
+}